@@ -0,0 +1,219 @@
+/**
+ * @file archive.c
+ * @brief Source file for tetris seekable replay archive
+ */
+
+#include "archive.h"
+
+bool create_archive(const char *path, uint32_t interval) {
+  char tmp[FILENAME_MAX];
+  if (interval == 0 ||
+      snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp))
+    return false;
+  int fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) return false;
+  ArchiveHeader_t header = {ARCHIVE_MAGIC, sizeof(ArchiveHeader_t),
+                            ARCHIVE_VERSION, ENGINE_VERSION,
+                            DELAY,           INIT_TIMER,
+                            INIT_LEVEL,      FIELD_ROWS,
+                            FIELD_COLS,      interval};
+  bool res = write(fd, &header, sizeof(header)) == sizeof(header) &&
+             fsync(fd) == 0;
+  res = close(fd) == 0 && res && rename(tmp, path) == 0;
+  if (!res) remove(tmp);
+  return res;
+}
+
+bool append_archive(const char *path, const Replay_t *replay) {
+  int fd = open(path, O_RDWR);
+  if (fd == -1) return false;
+  ArchiveHeader_t header;
+  ArchiveEntry_t entry = {.keyframes = 0};
+  Keyframe_t *keyframes = NULL;
+  unsigned char *data = NULL;
+  bool res = pread(fd, &header, sizeof(header), 0) == sizeof(header) &&
+             is_archive_compatible(&header) &&
+             build_keyframes(replay, header.interval, &keyframes, &entry);
+  size_t frames = entry.keyframes * sizeof(Keyframe_t);
+  if (res) data = calloc(1, entry.size);
+  if (data != NULL) {
+    memcpy(data, &entry, sizeof(entry));
+    memcpy(data + sizeof(entry), keyframes, frames);
+    memcpy(data + sizeof(entry) + frames, replay->data, replay->size);
+    uint64_t length = header.length + entry.size;
+    res = pwrite(fd, data, entry.size, header.length) ==
+              (ssize_t)entry.size &&
+          fsync(fd) == 0 &&
+          pwrite(fd, &length, sizeof(length),
+                 offsetof(ArchiveHeader_t, length)) == sizeof(length) &&
+          fsync(fd) == 0;
+  } else {
+    res = false;
+  }
+  free(data);
+  free(keyframes);
+  close(fd);
+  return res;
+}
+
+bool build_keyframes(const Replay_t *replay, uint32_t interval,
+                     Keyframe_t **keyframes, ArchiveEntry_t *entry) {
+  Replay_t reader = *replay;
+  reader.offset = 0;
+  reader.complete = false;
+  ExpandedGameInfo_t info;
+  create_seeded_game(&info, replay->header.seed);
+  size_t count = 0, capacity = 0, offset = 0;
+  uint64_t tick = 0, last = 0, boundary = 0, delta;
+  UserAction_t action;
+  bool running = true, ok = true;
+  *keyframes = NULL;
+  while (running && ok && next_replay_event(&reader, &delta, &action)) {
+    uint64_t target = last + delta;
+    for (; ok && boundary < target; boundary += interval) {
+      advance_ticks(&info, boundary - tick);
+      tick = boundary;
+      if (count == capacity) {
+        capacity = capacity ? 2 * capacity : 64;
+        Keyframe_t *grown = realloc(*keyframes, capacity * sizeof(Keyframe_t));
+        ok = grown != NULL;
+        if (ok) *keyframes = grown;
+      }
+      if (ok) {
+        Keyframe_t *keyframe = &(*keyframes)[count++];
+        save_game(&info, &keyframe->state);
+        keyframe->tick = boundary;
+        keyframe->offset = offset;
+        keyframe->elapsed = boundary - last;
+      }
+    }
+    advance_ticks(&info, target - tick);
+    tick = last = target;
+    if (action == Terminate)
+      running = false;
+    else
+      process_action(&info, action);
+    offset = reader.offset;
+  }
+  exit_game(&info);
+  size_t size = sizeof(ArchiveEntry_t) + count * sizeof(Keyframe_t) +
+                replay->size;
+  *entry = (ArchiveEntry_t){(size + 7) & ~(size_t)7,
+                            replay->header.seed,
+                            last,
+                            replay->size,
+                            (uint32_t)count,
+                            reader.complete,
+                            reader.summary};
+  if (!ok) {
+    free(*keyframes);
+    *keyframes = NULL;
+  }
+  return ok;
+}
+
+bool is_archive_compatible(const ArchiveHeader_t *header) {
+  return memcmp(header->magic, ARCHIVE_MAGIC, sizeof(header->magic)) == 0 &&
+         header->version == ARCHIVE_VERSION &&
+         header->engine == ENGINE_VERSION && header->delay == DELAY &&
+         header->init_timer == INIT_TIMER &&
+         header->init_level == INIT_LEVEL && header->rows == FIELD_ROWS &&
+         header->cols == FIELD_COLS && header->interval > 0 &&
+         header->length >= sizeof(ArchiveHeader_t);
+}
+
+bool open_archive(Archive_t *archive, const char *path) {
+  bool res = false;
+  *archive = (Archive_t){NULL, 0, NULL, NULL, 0};
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) return res;
+  ArchiveHeader_t header;
+  struct stat st;
+  if (pread(fd, &header, sizeof(header), 0) == sizeof(header) &&
+      is_archive_compatible(&header) && fstat(fd, &st) == 0 &&
+      header.length <= (uint64_t)st.st_size) {
+    void *map = mmap(NULL, header.length, PROT_READ, MAP_SHARED, fd, 0);
+    if (map != MAP_FAILED) {
+      archive->map = map;
+      archive->size = header.length;
+      archive->header = map;
+      res = true;
+    }
+  }
+  close(fd);
+  size_t offset = sizeof(ArchiveHeader_t), capacity = 0;
+  while (res && offset < archive->size) {
+    const ArchiveEntry_t *entry =
+        (const ArchiveEntry_t *)((const char *)archive->map + offset);
+    res = archive->size - offset >= sizeof(ArchiveEntry_t) &&
+          entry->size % 8 == 0 && entry->size <= archive->size - offset &&
+          sizeof(ArchiveEntry_t) + entry->keyframes * sizeof(Keyframe_t) +
+                  entry->events <=
+              entry->size;
+    if (res && archive->count == capacity) {
+      capacity = capacity ? 2 * capacity : 64;
+      const ArchiveEntry_t **grown =
+          realloc(archive->entries, capacity * sizeof(ArchiveEntry_t *));
+      res = grown != NULL;
+      if (res) archive->entries = grown;
+    }
+    if (res) {
+      archive->entries[archive->count++] = entry;
+      offset += entry->size;
+    }
+  }
+  if (!res) close_archive(archive);
+  return res;
+}
+
+void close_archive(Archive_t *archive) {
+  if (archive->map != NULL) munmap(archive->map, archive->size);
+  free(archive->entries);
+  *archive = (Archive_t){NULL, 0, NULL, NULL, 0};
+}
+
+const Keyframe_t *find_keyframe(const ArchiveEntry_t *entry, uint64_t tick) {
+  const Keyframe_t *keyframes = (const Keyframe_t *)(entry + 1);
+  size_t left = 0, right = entry->keyframes;
+  while (left < right) {
+    size_t mid = left + (right - left) / 2;
+    if (keyframes[mid].tick <= tick) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  return left > 0 ? &keyframes[left - 1] : NULL;
+}
+
+bool seek_archive(const Archive_t *archive, size_t index, uint64_t tick,
+                  ExpandedGameInfo_t *info) {
+  if (index >= archive->count) return false;
+  const ArchiveEntry_t *entry = archive->entries[index];
+  const Keyframe_t *keyframe = find_keyframe(entry, tick);
+  Replay_t reader = {
+      .data = (unsigned char *)(entry + 1) +
+              entry->keyframes * sizeof(Keyframe_t),
+      .size = entry->events};
+  uint64_t last = 0, cur = 0, delta;
+  create_seeded_game(info, entry->seed);
+  if (keyframe != NULL && restore_game(info, &keyframe->state)) {
+    reader.offset = keyframe->offset;
+    cur = keyframe->tick;
+    last = cur - keyframe->elapsed;
+  }
+  if (tick > entry->ticks) tick = entry->ticks;
+  UserAction_t action;
+  bool running = true;
+  while (running && next_replay_event(&reader, &delta, &action)) {
+    uint64_t target = last + delta;
+    running = target <= tick && action != Terminate;
+    if (target <= tick) {
+      advance_ticks(info, target - cur);
+      cur = last = target;
+    }
+    if (running) process_action(info, action);
+  }
+  advance_ticks(info, tick - cur);
+  return true;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file archive.h
+ * @brief Tetris seekable replay archive header file
+ */
+
+#ifndef TETRIS_ARCHIVE_H
+#define TETRIS_ARCHIVE_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "replay.h"
+#include "save.h"
+
+/**
+ * @brief Creates an empty replay archive.
+ *
+ * The file is written under a temporary name and renamed into place, so an
+ * existing archive is either kept or replaced as a whole.
+ *
+ * @param path The path to the archive file.
+ * @param interval The number of game iterations between keyframes, at least 1.
+ * @return bool `true` if the archive has been created, otherwise `false`.
+ *
+ * @see ArchiveHeader_t
+ * @see append_archive
+ */
+bool create_archive(const char* path, uint32_t interval);
+/**
+ * @brief Appends a replay to an archive.
+ *
+ * The replay is played back once to take a keyframe every `interval` game
+ * iterations of the archive. The entry is written past the committed part of
+ * the file and synced to the disk before the header is updated to include it,
+ * so a crash at any moment leaves the archive readable with or without the
+ * new replay. Processes that have the archive open keep seeing the replays it
+ * had when they opened it.
+ *
+ * @param path The path to the archive file.
+ * @param replay A pointer to the `Replay_t` structure containing the loaded
+ * replay. It is not modified.
+ * @return bool `true` if the replay has been appended, otherwise `false`.
+ *
+ * @see ArchiveEntry_t
+ * @see Keyframe_t
+ * @see load_replay
+ */
+bool append_archive(const char* path, const Replay_t* replay);
+/**
+ * @brief Plays a replay back and takes its keyframes.
+ *
+ * A keyframe is taken at every multiple of `interval` game iterations that is
+ * followed by another record, starting with iteration 0.
+ *
+ * @param replay A pointer to the `Replay_t` structure containing the loaded
+ * replay. It is not modified.
+ * @param interval The number of game iterations between keyframes.
+ * @param keyframes A pointer to the array of keyframes allocated by the
+ * function. It must be freed by the caller.
+ * @param entry A pointer to the `ArchiveEntry_t` structure the description of
+ * the replay in the archive is written to.
+ * @return bool `true` if the keyframes have been taken, or `false` if memory
+ * runs out.
+ *
+ * @see Keyframe_t
+ * @see ArchiveEntry_t
+ * @see save_game
+ */
+bool build_keyframes(const Replay_t* replay, uint32_t interval,
+                     Keyframe_t** keyframes, ArchiveEntry_t* entry);
+/**
+ * @brief Checks if an archive was written with the current rules.
+ *
+ * @param header A pointer to the `ArchiveHeader_t` structure to be checked.
+ * @return bool `true` if the signature, the versions and the rules match,
+ * otherwise `false`.
+ *
+ * @see ArchiveHeader_t
+ */
+bool is_archive_compatible(const ArchiveHeader_t* header);
+/**
+ * @brief Maps a replay archive into memory.
+ *
+ * This function maps the committed part of the file read-only and checks its
+ * header and the bounds of its entries. The keyframes and the records are used
+ * directly from the mapping. The file must have been written on a machine
+ * with the same byte order.
+ *
+ * @param archive A pointer to the `Archive_t` structure to be initialized.
+ * @param path The path to the archive file.
+ * @return bool `true` if the archive has been opened, otherwise `false`.
+ *
+ * @see Archive_t
+ * @see close_archive
+ */
+bool open_archive(Archive_t* archive, const char* path);
+/**
+ * @brief Unmaps a replay archive.
+ *
+ * @param archive A pointer to the `Archive_t` structure to be released.
+ *
+ * @see open_archive
+ */
+void close_archive(Archive_t* archive);
+/**
+ * @brief Finds the keyframe to resume a replay of an archive from.
+ *
+ * This function does a binary search over the keyframes of the entry.
+ *
+ * @param entry A pointer to the `ArchiveEntry_t` structure of the replay.
+ * @param tick The game iteration to be reached.
+ * @return const Keyframe_t* A pointer to the last keyframe taken at or before
+ * `tick`, or `NULL` if there is none.
+ *
+ * @see Keyframe_t
+ * @see seek_archive
+ */
+const Keyframe_t* find_keyframe(const ArchiveEntry_t* entry, uint64_t tick);
+/**
+ * @brief Sets up a game at a given moment of an archived replay.
+ *
+ * The game is restored from the nearest keyframe and played on up to `tick`
+ * from there, so at most `interval` game iterations are simulated. If the
+ * keyframe is damaged, the replay is played from the start instead. Iterations
+ * past the end of the replay are clamped to its last record. The game must be
+ * released with `exit_game`.
+ *
+ * @param archive A pointer to the `Archive_t` structure of the archive.
+ * @param index The index of the replay in the archive.
+ * @param tick The game iteration; all the actions recorded at it are applied.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure the game is
+ * created in.
+ * @return bool `true` if the game has been set up, or `false` if there is no
+ * such replay.
+ *
+ * @see find_keyframe
+ * @see restore_game
+ */
+bool seek_archive(const Archive_t* archive, size_t index, uint64_t tick,
+                  ExpandedGameInfo_t* info);
+
+#endif
@@ -4,6 +4,7 @@
  */
 
 #include "backend.h"
+#include "rewind.h"
 
 UserAction_t user_action(int key) {
   UserAction_t action;
@@ -46,38 +47,75 @@ ExpandedGameInfo_t *get_instance() {
   static ExpandedGameInfo_t instance;
   static int game_number = 0;
   if (instance.info.field == NULL) {
-    instance.info.field = calloc(FIELD_ROWS, sizeof(int *));
-    for (int i = 0; i < FIELD_ROWS; i++) {
-      instance.info.field[i] = calloc(FIELD_COLS, sizeof(int));
-    }
-    instance.info.next = calloc(NEXT_ROWS, sizeof(int *));
-    for (int i = 0; i < NEXT_ROWS; i++) {
-      instance.info.next[i] = calloc(NEXT_COLS, sizeof(int));
-    }
-
-    instance.info.score = INIT_SCORE;
-    instance.info.high_score = load_high_score();
-    instance.info.level = INIT_LEVEL;
-    instance.info.speed = instance.info.level;
-    instance.info.pause = 0;
-
     srand(time(NULL) ^ getpid());
-    instance.cur_piece = random_piece();
-    instance.next_piece = random_piece();
-    fill_next_piece(&instance.info, instance.next_piece);
-    instance.timer = INIT_TIMER;
+    create_game(&instance);
     if (game_number) {
       instance.state = -1;
       instance.prev_state = Game_over;
-    } else {
-      instance.state = Begin;
-      instance.prev_state = Begin;
     }
     game_number++;
   }
   return &instance;
 }
 
+void create_game(ExpandedGameInfo_t *info) {
+  create_seeded_game(info, (uint64_t)rand() << 32 ^ (uint64_t)rand());
+}
+
+void create_seeded_game(ExpandedGameInfo_t *info, uint64_t seed) {
+  GameStorage_t *storage = malloc(sizeof(GameStorage_t));
+  storage->pooled = false;
+  attach_storage(info, storage);
+  info->rewind = NULL;
+  info->bus = NULL;
+  init_seeded_game(info, seed);
+}
+
+void attach_storage(ExpandedGameInfo_t *info, GameStorage_t *storage) {
+  for (int i = 0; i < FIELD_ROWS; i++) storage->rows[i] = storage->cells[i];
+  for (int i = 0; i < NEXT_ROWS; i++) storage->next[i] = storage->preview[i];
+  info->storage = storage;
+  info->info.field = storage->rows;
+  info->info.next = storage->next;
+}
+
+void init_seeded_game(ExpandedGameInfo_t *info, uint64_t seed) {
+  info->seed = info->rng = seed;
+  info->lines = 0;
+  clear_field(&info->info);
+
+  info->info.score = INIT_SCORE;
+  info->info.high_score = load_high_score();
+  info->info.level = INIT_LEVEL;
+  info->info.speed = info->info.level;
+  info->info.pause = 0;
+
+  info->cur_piece = draw_piece(&info->rng);
+  info->next_piece = draw_piece(&info->rng);
+  fill_next_piece(&info->info, info->next_piece);
+  info->timer = INIT_TIMER;
+  info->state = Begin;
+  info->prev_state = Begin;
+  mark_all_changed(&info->changes);
+}
+
+size_t get_game_memory(const ExpandedGameInfo_t *info) {
+  size_t size = sizeof(ExpandedGameInfo_t);
+  if (info->storage != NULL && info->storage->pooled) {
+    size = sizeof(PoolSlot_t);
+  } else if (info->storage != NULL) {
+    size += sizeof(GameStorage_t);
+  } else {
+    if (info->info.field != NULL)
+      size += FIELD_ROWS * (sizeof(int *) + FIELD_COLS * sizeof(int));
+    if (info->info.next != NULL)
+      size += NEXT_ROWS * (sizeof(int *) + NEXT_COLS * sizeof(int));
+  }
+  if (info->rewind != NULL) size += sizeof(Rewind_t);
+  if (info->bus != NULL) size += sizeof(EventBus_t);
+  return size;
+}
+
 bool is_beyond_bounds(int row, int col) {
   bool res = false;
   if (row < 0 || row >= FIELD_ROWS || col < 0 || col >= FIELD_COLS) res = true;
@@ -163,25 +201,37 @@ int clear_full_rows(ExpandedGameInfo_t *info) {
     erase = true;
     remove_piece(&info->info, info->cur_piece);
   }
+  int lowest = FIELD_ROWS - 1;
+  while (lowest >= 0 && !is_row_full(&info->info, lowest)) lowest--;
+  if (lowest >= 0) {
+    if (info->rewind != NULL) record_rows(info->rewind, &info->info);
+    count = collapse_full_rows(&info->info);
+    info->changes.rows |= (uint32_t)((2ULL << lowest) - 1);
+  }
+  if (erase) place_piece(&info->info, info->cur_piece);
+  if (count)
+    info->state = Score_up;
+  else
+    info->state = Play;
+  return count;
+}
+
+int collapse_full_rows(GameInfo_t *info) {
+  int count = 0;
   for (int i = FIELD_ROWS - 1; i >= 0; i--) {
-    if (is_row_full(&info->info, i)) {
+    if (is_row_full(info, i)) {
       count++;
       for (int k = i; k > 0; k--) {
         for (int j = 0; j < FIELD_COLS; j++) {
-          info->info.field[k][j] = info->info.field[k - 1][j];
+          info->field[k][j] = info->field[k - 1][j];
         }
       }
       for (int j = 0; j < FIELD_COLS; j++) {
-        info->info.field[0][j] = 0;
+        info->field[0][j] = 0;
       }
       i++;
     }
   }
-  if (erase) place_piece(&info->info, info->cur_piece);
-  if (count)
-    info->state = Score_up;
-  else
-    info->state = Play;
   return count;
 }
 
@@ -227,35 +277,70 @@ void update_timer(ExpandedGameInfo_t *info) {
     info->state = Move;
 }
 
-void make_shift(ExpandedGameInfo_t *info) {
+int get_idle_ticks(ExpandedGameInfo_t *info) {
+  int res = 0;
+  if (info->state == Play && info->timer > 0) res = (info->timer - 1) / DELAY;
+  return res;
+}
+
+int skip_ticks(ExpandedGameInfo_t *info, int count) {
+  int idle = get_idle_ticks(info);
+  if (count > idle) count = idle;
+  if (count > 0) info->timer -= count * DELAY;
+  if (count > 0 && info->rewind != NULL) info->rewind->ticks += count;
+  return count > 0 ? count : 0;
+}
+
+bool make_shift(ExpandedGameInfo_t *info, bool *spawned) {
+  Piece_t before = info->cur_piece;
   remove_piece(&info->info, info->cur_piece);
   info->cur_piece.coords.row++;
-  if (!can_place(&info->info, info->cur_piece)) {
+  bool locked = !can_place(&info->info, info->cur_piece);
+  if (locked) {
     info->cur_piece.coords.row--;
     place_piece(&info->info, info->cur_piece);
+    if (info->rewind != NULL) record_lock(info->rewind, info);
+    emit_event(info, Piece_locked, info->cur_piece.type);
     update_current_piece(info);
   }
   info->timer = get_iteration_delay(info->info.level);
-  if (can_place(&info->info, info->cur_piece))
-    place_piece(&info->info, info->cur_piece);
+  bool placed = can_place(&info->info, info->cur_piece);
+  if (placed) place_piece(&info->info, info->cur_piece);
+  if (spawned != NULL) *spawned = placed;
   info->state = Move;
+  mark_piece_rows(&info->changes, before);
+  mark_piece_rows(&info->changes, info->cur_piece);
+  return locked;
 }
 
 void update_current_piece(ExpandedGameInfo_t *info) {
   info->cur_piece = info->next_piece;
-  info->next_piece = random_piece();
+  info->next_piece = draw_piece(&info->rng);
   fill_next_piece(&info->info, info->next_piece);
+  if (info->next_piece.type != info->cur_piece.type) info->changes.next = true;
 }
 
 Piece_t random_piece() {
   Piece_t res;
   res.type = 1 + (rand() % PIECE_COUNT);
-  res.coords.row = 0;
-  res.coords.col = 5;
+  res.coords.row = SPAWN_ROW;
+  res.coords.col = SPAWN_COL;
   res.pos = 0;
   return res;
 }
 
+Piece_t draw_piece(uint64_t *rng) {
+  int type = 1 + (int)(next_random(rng) % PIECE_COUNT);
+  return (Piece_t){type, {SPAWN_ROW, SPAWN_COL}, 0};
+}
+
+uint64_t next_random(uint64_t *rng) {
+  uint64_t z = (*rng += RANDOM_INCREMENT);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
 void fill_next_piece(GameInfo_t *info, Piece_t piece) {
   for (int i = 0; i < NEXT_ROWS; i++) {
     for (int j = 0; j < NEXT_COLS; j++) {
@@ -271,6 +356,7 @@ void fill_next_piece(GameInfo_t *info, Piece_t piece) {
 }
 
 void make_move(ExpandedGameInfo_t *info, UserAction_t action) {
+  Piece_t before = info->cur_piece;
   switch (action) {
     case Right:
       move_piece_side(&info->info, &info->cur_piece, RIGHT);
@@ -290,6 +376,12 @@ void make_move(ExpandedGameInfo_t *info, UserAction_t action) {
     default:
       break;
   }
+  if (before.coords.row != info->cur_piece.coords.row ||
+      before.coords.col != info->cur_piece.coords.col ||
+      before.pos != info->cur_piece.pos) {
+    mark_piece_rows(&info->changes, before);
+    mark_piece_rows(&info->changes, info->cur_piece);
+  }
 }
 
 void increase_score(GameInfo_t *info, int count) {
@@ -298,7 +390,7 @@ void increase_score(GameInfo_t *info, int count) {
     info->high_score = info->score;
     save_high_score(info);
   }
-  if (info->level < 10) {
+  if (info->level < MAX_LEVEL) {
     while (info->score >= get_level_boundary(info->level)) {
       info->level++;
       info->speed++;
@@ -353,9 +445,16 @@ Coordinate_t get_piece_shifts(int piece, int pos, int num) {
   return shifts[piece - 1][pos][num];
 }
 
+static const char *high_score_path = FILE_PATH;
+static pthread_mutex_t writer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t writer_wake = PTHREAD_COND_INITIALIZER;
+static pthread_t writer_thread;
+static bool writer_running = false, writer_stop = false, writer_dirty = false;
+static int writer_score = 0, writer_writes = 0;
+
 int load_high_score() {
   int high_score = 0;
-  FILE *file = fopen(FILE_PATH, "r");
+  FILE *file = high_score_path ? fopen(high_score_path, "r") : NULL;
   if (file != NULL) {
     fscanf(file, "%d", &high_score);
     fclose(file);
@@ -364,21 +463,115 @@ int load_high_score() {
 }
 
 void save_high_score(GameInfo_t *info) {
-  FILE *file = fopen(FILE_PATH, "w");
-  if (file != NULL) {
-    fprintf(file, "%d", info->high_score);
-    fclose(file);
+  pthread_mutex_lock(&writer_lock);
+  bool queued = writer_running;
+  if (queued) {
+    if (!writer_dirty || writer_score < info->high_score)
+      writer_score = info->high_score;
+    writer_dirty = true;
+    pthread_cond_signal(&writer_wake);
+  }
+  const char *path = high_score_path;
+  pthread_mutex_unlock(&writer_lock);
+  if (!queued && path != NULL) write_high_score(path, info->high_score);
+}
+
+void set_high_score_file(const char *path) {
+  pthread_mutex_lock(&writer_lock);
+  high_score_path = path;
+  pthread_mutex_unlock(&writer_lock);
+}
+
+bool write_high_score(const char *path, int high_score) {
+  char tmp[FILENAME_MAX];
+  if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp))
+    return false;
+  FILE *file = fopen(tmp, "w");
+  if (file == NULL) return false;
+  bool res = fprintf(file, "%d", high_score) > 0 && fflush(file) == 0 &&
+             fsync(fileno(file)) == 0;
+  res = fclose(file) == 0 && res && rename(tmp, path) == 0;
+  if (!res) remove(tmp);
+  return res;
+}
+
+bool start_high_score_writer() {
+  pthread_mutex_lock(&writer_lock);
+  if (!writer_running) {
+    writer_stop = false;
+    writer_writes = 0;
+    writer_running =
+        pthread_create(&writer_thread, NULL, run_high_score_writer, NULL) == 0;
+  }
+  bool res = writer_running;
+  pthread_mutex_unlock(&writer_lock);
+  return res;
+}
+
+int stop_high_score_writer() {
+  pthread_mutex_lock(&writer_lock);
+  bool running = writer_running;
+  writer_stop = true;
+  pthread_cond_signal(&writer_wake);
+  pthread_mutex_unlock(&writer_lock);
+  if (running) pthread_join(writer_thread, NULL);
+  pthread_mutex_lock(&writer_lock);
+  writer_running = false;
+  int res = writer_writes;
+  pthread_mutex_unlock(&writer_lock);
+  return res;
+}
+
+void *run_high_score_writer(void *arg) {
+  (void)arg;
+  pthread_mutex_lock(&writer_lock);
+  while (!writer_stop || writer_dirty) {
+    if (!writer_dirty) {
+      pthread_cond_wait(&writer_wake, &writer_lock);
+      continue;
+    }
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += HIGH_SCORE_COALESCE_MS * 1000000L;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+    deadline.tv_nsec %= 1000000000L;
+    while (!writer_stop && pthread_cond_timedwait(&writer_wake, &writer_lock,
+                                                  &deadline) == 0) {
+    }
+    int high_score = writer_score;
+    const char *path = high_score_path;
+    writer_dirty = false;
+    pthread_mutex_unlock(&writer_lock);
+    bool written = path != NULL && write_high_score(path, high_score);
+    pthread_mutex_lock(&writer_lock);
+    writer_writes += written;
   }
+  pthread_mutex_unlock(&writer_lock);
+  return NULL;
 }
 
 void userInput(UserAction_t action, bool hold) {
   ExpandedGameInfo_t *info = get_instance();
+  process_input(info, action, hold);
+}
+
+bool process_input(ExpandedGameInfo_t *info, UserAction_t action, bool hold) {
+  return step_game(info, action, hold, true);
+}
+
+void process_action(ExpandedGameInfo_t *info, UserAction_t action) {
+  step_game(info, action, false, false);
+}
+
+bool step_game(ExpandedGameInfo_t *info, UserAction_t action, bool hold,
+               bool tick) {
+  GameInfo_t before = info->info;
   info->prev_state = info->state;
   if (hold) info->state = -1;
   if (action == Terminate) {
     info->state = Exit;
     exit_game(info);
-    return;
+    return false;
   }
   if (action == Pause) {
     info->info.pause = 1;
@@ -388,22 +581,103 @@ void userInput(UserAction_t action, bool hold) {
     info->info.pause = 0;
     info->state = Play;
   }
+  if (info->state != Play) tick = false;
   if (info->state == Play) {
-    update_timer(info);
-    if (info->state == Shift) make_shift(info);
-    if (info->state == Move) make_move(info, action);
-    int rows = clear_full_rows(info);
-    if (info->state == Score_up) {
-      increase_score(&info->info, rows);
-      info->state = Play;
-    }
-    sleep_ms(DELAY);
+    if (tick && info->rewind != NULL) info->rewind->ticks++;
+    if (tick)
+      update_timer(info);
+    else
+      info->state = Move;
+    bool spawned = true;
+    bool locked = info->state == Shift && make_shift(info, &spawned);
+    if (info->state == Move && spawned) make_move(info, action);
+    info->state = Play;
+    if (locked) settle_lock(info, spawned);
   }
-  if (is_game_over(info)) {
+  handle_states(info);
+  track_changes(info, before);
+  return tick;
+}
+
+void settle_lock(ExpandedGameInfo_t *info, bool spawned) {
+  int level = info->info.level;
+  int rows = spawned ? clear_full_rows(info) : 0;
+  if (info->state == Score_up) {
+    info->lines += rows;
+    increase_score(&info->info, rows);
+    info->state = Play;
+    emit_event(info, Rows_cleared, rows);
+    if (info->info.level != level)
+      emit_event(info, Level_up, info->info.level);
+  }
+  if (!spawned || is_game_over(info)) {
     info->state = Game_over;
     clear_field(&info->info);
+    if (info->rewind != NULL) clear_rewind(info->rewind);
+    info->changes.rows = FIELD_ROWS_MASK;
+    emit_event(info, Topped_out, info->info.score);
+  } else {
+    emit_event(info, Piece_spawned, info->cur_piece.type);
   }
-  handle_states(info);
+}
+
+bool subscribe_events(EventBus_t *bus, EventHandler_t handler, void *context,
+                      unsigned mask) {
+  if (bus->count >= EVENT_SUBSCRIBERS) return false;
+  bus->subscribers[bus->count++] = (Subscriber_t){handler, context, mask};
+  return true;
+}
+
+void unsubscribe_events(EventBus_t *bus, EventHandler_t handler,
+                        void *context) {
+  int count = 0;
+  for (int i = 0; i < bus->count; i++) {
+    Subscriber_t subscriber = bus->subscribers[i];
+    if (subscriber.handler != handler || subscriber.context != context)
+      bus->subscribers[count++] = subscriber;
+  }
+  bus->count = count;
+}
+
+void emit_event(ExpandedGameInfo_t *info, GameEvent_t event, int value) {
+  EventBus_t *bus = info->bus;
+  if (bus == NULL) return;
+  for (int i = 0; i < bus->count; i++) {
+    const Subscriber_t *subscriber = &bus->subscribers[i];
+    if (subscriber->mask & 1u << event)
+      subscriber->handler(subscriber->context, &info->info, event, value);
+  }
+}
+
+void track_changes(ExpandedGameInfo_t *info, GameInfo_t before) {
+  GameInfo_t *after = &info->info;
+  if (before.score != after->score) info->changes.fields |= Score_changed;
+  if (before.high_score != after->high_score)
+    info->changes.fields |= High_score_changed;
+  if (before.level != after->level) info->changes.fields |= Level_changed;
+  if (before.speed != after->speed) info->changes.fields |= Speed_changed;
+  if (before.pause != after->pause) info->changes.fields |= Pause_changed;
+}
+
+void mark_piece_rows(Changes_t *changes, Piece_t piece) {
+  for (int i = 0; i < PIECE_SIZE; i++) {
+    Coordinate_t shift = get_piece_shifts(piece.type, piece.pos, i);
+    int row = piece.coords.row + shift.row;
+    if (row >= 0 && row < FIELD_ROWS) changes->rows |= 1u << row;
+  }
+}
+
+void mark_all_changed(Changes_t *changes) {
+  changes->rows = FIELD_ROWS_MASK;
+  changes->fields = Score_changed | High_score_changed | Level_changed |
+                    Speed_changed | Pause_changed;
+  changes->next = true;
+}
+
+Changes_t get_changes(ExpandedGameInfo_t *info) { return info->changes; }
+
+void reset_changes(ExpandedGameInfo_t *info) {
+  info->changes = (Changes_t){0, 0, false};
 }
 
 GameInfo_t updateCurrentState() {
@@ -436,11 +710,25 @@ void clear_field(GameInfo_t *info) {
 }
 
 void reset_game(ExpandedGameInfo_t *info) {
-  exit_game(info);
-  info = get_instance();
+  if (info->info.field == NULL) {
+    Rewind_t *rewind = info->rewind;
+    EventBus_t *bus = info->bus;
+    create_seeded_game(info, info->rng);
+    info->rewind = rewind;
+    info->bus = bus;
+  } else {
+    init_seeded_game(info, info->rng);
+  }
+  if (info->rewind != NULL) clear_rewind(info->rewind);
 }
 
 void exit_game(ExpandedGameInfo_t *info) {
+  if (info->storage != NULL) {
+    if (!info->storage->pooled) free(info->storage);
+    info->storage = NULL;
+    info->info.field = NULL;
+    info->info.next = NULL;
+  }
   if (info->info.field != NULL) {
     for (int i = 0; i < FIELD_ROWS; i++) {
       free(info->info.field[i]);
@@ -6,9 +6,12 @@
 #ifndef TETRIS_BACKEND_H
 #define TETRIS_BACKEND_H
 
+#ifndef _XOPEN_SOURCE
 #define _XOPEN_SOURCE 500
+#endif
 
 #include <ncurses.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <time.h>
@@ -20,11 +23,10 @@
 /**
  * @brief Processes user input and updates the game state accordingly.
  *
- * This function processes user input and updates the game state based on the
- * input action. The function handles various actions such as terminating the
- * game, pausing the game, starting the game, and moving or rotating the current
- * piece. It also updates the game timer, performs shift operations, clears full
- * rows, and checks if the game is over.
+ * This function processes user input for the game instance returned by
+ * `get_instance` using the `process_input` function. Every call in the `Play`
+ * state is one game iteration; the function never pauses, the caller paces the
+ * iterations (see `get_idle_ticks`).
  *
  * @param action The `UserAction_t` representing the user action to be
  * processed.
@@ -33,16 +35,7 @@
  *
  * @see UserAction_t
  * @see get_instance
- * @see exit_game
- * @see update_timer
- * @see make_shift
- * @see make_move
- * @see clear_full_rows
- * @see increase_score
- * @see sleep_ms
- * @see is_game_over
- * @see clear_field
- * @see handle_states
+ * @see process_input
  */
 void userInput(UserAction_t action, bool hold);
 /**
@@ -61,6 +54,191 @@ void userInput(UserAction_t action, bool hold);
  */
 GameInfo_t updateCurrentState();
 
+/**
+ * @brief Processes user input for a game and updates its state accordingly.
+ *
+ * This function processes user input and updates the game state based on the
+ * input action. The function handles various actions such as terminating the
+ * game, pausing the game, starting the game, and moving or rotating the current
+ * piece. It also updates the game timer and performs shift operations. When a
+ * piece is locked, it clears full rows, updates the score and checks if the
+ * game is over. Unlike `userInput`, it works on any game instance, so that
+ * several games can be driven by one caller.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param action The `UserAction_t` representing the user action to be
+ * processed.
+ * @param hold A boolean indicating whether the action is a hold action (not
+ * used)
+ * @return bool `true` if the game timer has been advanced, otherwise `false`.
+ *
+ * @see ExpandedGameInfo_t
+ * @see UserAction_t
+ * @see exit_game
+ * @see update_timer
+ * @see make_shift
+ * @see make_move
+ * @see settle_lock
+ * @see handle_states
+ */
+bool process_input(ExpandedGameInfo_t* info, UserAction_t action, bool hold);
+/**
+ * @brief Applies a user action to a game between its iterations.
+ *
+ * This function handles the action like `process_input`, but does not advance
+ * the game timer, so the action is applied as soon as it arrives and any
+ * number of actions can be applied between two game iterations.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param action The `UserAction_t` representing the user action to be
+ * processed.
+ *
+ * @see process_input
+ * @see step_game
+ */
+void process_action(ExpandedGameInfo_t* info, UserAction_t action);
+/**
+ * @brief Processes a user action with or without a game iteration.
+ *
+ * This function contains the logic shared by `process_input` and
+ * `process_action`. In the `Play` state the game timer is advanced only if
+ * `tick` is set; otherwise the action is applied as a move right away.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param action The `UserAction_t` representing the user action to be
+ * processed.
+ * @param hold A boolean indicating whether the action is a hold action (not
+ * used)
+ * @param tick A boolean indicating whether the action comes with a game
+ * iteration.
+ * @return bool `true` if the game timer has been advanced, otherwise `false`.
+ *
+ * @see process_input
+ * @see process_action
+ */
+bool step_game(ExpandedGameInfo_t* info, UserAction_t action, bool hold,
+               bool tick);
+/**
+ * @brief Settles the game after a piece has been locked.
+ *
+ * The full rows are cleared, the score and the level are updated, and the
+ * game is over if the spawned piece could not be placed or the spawn area is
+ * taken. These checks can only change their outcome after a lock, so they are
+ * not run on other game steps. The corresponding events are emitted to the
+ * subscribers.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state, right after `make_shift` has locked a piece.
+ * @param spawned A boolean indicating whether `make_shift` has placed the
+ * spawned piece on the field.
+ *
+ * @see clear_full_rows
+ * @see increase_score
+ * @see is_game_over
+ * @see emit_event
+ */
+void settle_lock(ExpandedGameInfo_t* info, bool spawned);
+/**
+ * @brief Subscribes a handler to the events of a game.
+ *
+ * The handler is called synchronously, from within the game step that caused
+ * the event, with the game in a consistent state.
+ *
+ * @param bus A pointer to the `EventBus_t` structure attached to the game.
+ * @param handler The function handling the events.
+ * @param context The first argument passed to the handler.
+ * @param mask The events to be delivered, a mask of `1u << GameEvent_t`.
+ * @return bool `true` if the handler has been subscribed, `false` if there
+ * are already `EVENT_SUBSCRIBERS` subscriptions.
+ *
+ * @see GameEvent_t
+ * @see unsubscribe_events
+ */
+bool subscribe_events(EventBus_t* bus, EventHandler_t handler, void* context,
+                      unsigned mask);
+/**
+ * @brief Removes the subscriptions of a handler with a context.
+ *
+ * @param bus A pointer to the `EventBus_t` structure attached to the game.
+ * @param handler The function handling the events.
+ * @param context The context the handler was subscribed with.
+ *
+ * @see subscribe_events
+ */
+void unsubscribe_events(EventBus_t* bus, EventHandler_t handler,
+                        void* context);
+/**
+ * @brief Delivers an event to the subscribers of a game.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure of the game.
+ * Nothing is done if no `EventBus_t` is attached to it.
+ * @param event The event.
+ * @param value The value of the event.
+ *
+ * @see GameEvent_t
+ */
+void emit_event(ExpandedGameInfo_t* info, GameEvent_t event, int value);
+
+/**
+ * @brief Returns the changes of a game since they were last reset.
+ *
+ * The engine records which field rows, scalar fields and whether the next
+ * piece display area were changed by its functions, so frontends and other
+ * consumers can update only those parts instead of comparing whole states.
+ * The changes accumulate until `reset_changes` is called.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @return Changes_t The accumulated changes.
+ *
+ * @see Changes_t
+ * @see reset_changes
+ */
+Changes_t get_changes(ExpandedGameInfo_t* info);
+/**
+ * @brief Resets the changes of a game.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ *
+ * @see get_changes
+ */
+void reset_changes(ExpandedGameInfo_t* info);
+/**
+ * @brief Records the scalar fields changed by a game step.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state after the step.
+ * @param before The `GameInfo_t` structure of the game before the step.
+ *
+ * @see ChangedField_t
+ * @see step_game
+ */
+void track_changes(ExpandedGameInfo_t* info, GameInfo_t before);
+/**
+ * @brief Marks the field rows covered by a piece as changed.
+ *
+ * @param changes A pointer to the `Changes_t` structure to update.
+ * @param piece The `Piece_t` structure of the piece.
+ *
+ * @see Changes_t
+ */
+void mark_piece_rows(Changes_t* changes, Piece_t piece);
+/**
+ * @brief Marks everything as changed.
+ *
+ * This function is used when a game is created or its state is replaced as a
+ * whole.
+ *
+ * @param changes A pointer to the `Changes_t` structure to update.
+ *
+ * @see Changes_t
+ */
+void mark_all_changed(Changes_t* changes);
+
 /**
  * @brief Determines the user action based on the input key.
  *
@@ -90,11 +268,86 @@ UserAction_t user_action(int);
  * `ExpandedGameInfo_t`.
  *
  * @see ExpandedGameInfo_t
- * @see random_piece
+ * @see create_game
+ */
+ExpandedGameInfo_t* get_instance();
+/**
+ * @brief Allocates and initializes a new game.
+ *
+ * This function allocates the game field and the next piece display area of the
+ * given game instance in one block and initializes the score, high score,
+ * level, speed, pieces, timer and states of a new game that is waiting to be
+ * started.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure to be
+ * initialized.
+ *
+ * The pieces are drawn from a generator seeded from `rand`.
+ *
+ * @see ExpandedGameInfo_t
+ * @see create_seeded_game
+ * @see exit_game
+ */
+void create_game(ExpandedGameInfo_t* info);
+/**
+ * @brief Allocates and initializes a new game with a given seed.
+ *
+ * This function works like `create_game`, but the sequence of pieces is
+ * determined by the seed alone, so a game started with the same seed and
+ * given the same actions at the same game iterations always plays out the
+ * same way.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure to be
+ * initialized.
+ * @param seed The seed of the piece generator.
+ *
+ * @see ExpandedGameInfo_t
+ * @see draw_piece
  * @see fill_next_piece
  * @see load_high_score
+ * @see exit_game
  */
-ExpandedGameInfo_t* get_instance();
+void create_seeded_game(ExpandedGameInfo_t* info, uint64_t seed);
+/**
+ * @brief Points the game field and the next piece display area of a game to
+ * the given storage.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure of the game.
+ * @param storage A pointer to the `GameStorage_t` structure to be used.
+ *
+ * @see GameStorage_t
+ */
+void attach_storage(ExpandedGameInfo_t* info, GameStorage_t* storage);
+/**
+ * @brief Initializes a new game in place with a given seed.
+ *
+ * This function works like `create_seeded_game`, but nothing is allocated:
+ * the game field and the next piece display area the game already has are
+ * cleared, and the rewind history and the event subscribers are kept.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure of the game,
+ * with its storage attached.
+ * @param seed The seed of the piece generator.
+ *
+ * @see create_seeded_game
+ * @see reset_game
+ */
+void init_seeded_game(ExpandedGameInfo_t* info, uint64_t seed);
+/**
+ * @brief Returns the memory used by a game.
+ *
+ * The size covers the game structure, its field and next piece display area,
+ * and the rewind history and the event subscribers attached to it. A pooled
+ * game is counted as its pool slot. The bookkeeping of the allocator is not
+ * included.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure of the game.
+ * @return size_t The number of bytes used.
+ *
+ * @see GameStorage_t
+ * @see Save_t
+ */
+size_t get_game_memory(const ExpandedGameInfo_t* info);
 
 /**
  * @brief Checks if a given row and column are beyond the bounds of the game
@@ -144,7 +397,8 @@ bool is_row_full(GameInfo_t* info, int row);
  * top rows of the game field.
  *
  * This function checks if the game is over by examining the top rows of the
- * game field.
+ * game field. The current piece must be on the field: it is told apart from
+ * the locked cells only by its type and position.
  *
  * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
  * game state.
@@ -317,12 +571,43 @@ void rotate_piece(GameInfo_t* info, Piece_t* piece);
  * @see ExpandedGameInfo_t
  */
 void update_timer(ExpandedGameInfo_t* info);
+/**
+ * @brief Returns the number of idle game iterations before the next shift.
+ *
+ * An idle iteration is one without user input that only decrements the game
+ * timer. The frontend may wait for their total duration instead of running
+ * them one by one, and then account for them with `skip_ticks`.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game timer and state.
+ * @return int The number of idle iterations, 0 outside of the `Play` state.
+ *
+ * @see ExpandedGameInfo_t
+ * @see skip_ticks
+ */
+int get_idle_ticks(ExpandedGameInfo_t* info);
+/**
+ * @brief Accounts for idle game iterations at once.
+ *
+ * This function decrements the game timer as `count` idle iterations would.
+ * The count is limited by `get_idle_ticks`, so the iteration that shifts the
+ * piece is always processed by `process_input`.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game timer and state.
+ * @param count The number of idle iterations.
+ * @return int The number of iterations accounted for.
+ *
+ * @see ExpandedGameInfo_t
+ * @see get_idle_ticks
+ */
+int skip_ticks(ExpandedGameInfo_t* info, int count);
 /**
  * @brief Updates the current piece with the next piece and generates a new next
  * piece.
  *
  * This function updates the current piece in the game with the next piece and
- * then generates a new next piece using the `random_piece` function. The new
+ * then generates a new next piece using the `draw_piece` function. The new
  * next piece is then filled into the game field using the `fill_next_piece`
  * function.
  *
@@ -330,7 +615,7 @@ void update_timer(ExpandedGameInfo_t* info);
  * current and next pieces.
  *
  * @see ExpandedGameInfo_t
- * @see random_piece
+ * @see draw_piece
  * @see fill_next_piece
  */
 void update_current_piece(ExpandedGameInfo_t* info);
@@ -367,6 +652,10 @@ void fill_next_piece(GameInfo_t* info, Piece_t piece);
  *
  * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
  * game state.
+ * @param spawned A pointer set to whether the current piece is on the field
+ * afterwards, which is only `false` when a spawned piece is blocked, or
+ * `NULL`.
+ * @return bool `true` if the piece has been locked, otherwise `false`.
  *
  * @see ExpandedGameInfo_t
  * @see remove_piece
@@ -375,7 +664,7 @@ void fill_next_piece(GameInfo_t* info, Piece_t piece);
  * @see update_current_piece
  * @see get_iteration_delay
  */
-void make_shift(ExpandedGameInfo_t* info);
+bool make_shift(ExpandedGameInfo_t* info, bool* spawned);
 /**
  * @brief Processes a user action and updates the current piece accordingly.
  *
@@ -417,10 +706,26 @@ void make_move(ExpandedGameInfo_t* info, UserAction_t action);
  * @see ExpandedGameInfo_t
  * @see is_piece_on_field
  * @see remove_piece
- * @see is_row_full
+ * @see collapse_full_rows
  * @see place_piece
  */
 int clear_full_rows(ExpandedGameInfo_t* info);
+/**
+ * @brief Removes full rows from the game field.
+ *
+ * This function iterates through each row from the bottom to the top, and if a
+ * row is full, it shifts all rows above it down by one position and empties the
+ * top row. Unlike `clear_full_rows`, it works on a bare game field and does not
+ * touch the current piece or the game state.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @return int The number of rows removed.
+ *
+ * @see GameInfo_t
+ * @see is_row_full
+ */
+int collapse_full_rows(GameInfo_t* info);
 /**
  * @brief Increases the game score based on the number of cleared rows and
  * updates the high score if necessary.
@@ -472,7 +777,9 @@ void sleep_ms(int ms);
  * @brief Frees allocated memory.
  *
  * This function frees the allocated memory for the game field and the next
- * piece display area.
+ * piece display area. The storage of a pooled game is only detached, as it is
+ * returned to its pool by `release_game`. Areas allocated row by row are freed
+ * row by row.
  *
  * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
  * game field and next piece display area.
@@ -481,18 +788,19 @@ void sleep_ms(int ms);
  */
 void exit_game(ExpandedGameInfo_t* info);
 /**
- * @brief Resets the game by freeing allocated memory and refilling the game
- * instance.
+ * @brief Resets the game in place.
  *
- * This function resets the game by first freeing the allocated memory for the
- * game field and the next piece display area using the `exit_game` function.
+ * This function starts a new game in the same instance with
+ * `init_seeded_game`, reusing the game field and the next piece display area,
+ * so nothing is freed or allocated. The piece generator continues its
+ * sequence, so a session of several games stays deterministic. The rewind
+ * history is cleared. A game ended with `exit_game` is allocated again.
  *
  * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
  * game state and other game information.
  *
  * @see ExpandedGameInfo_t
- * @see exit_game
- * @see get_instance
+ * @see init_seeded_game
  */
 void reset_game(ExpandedGameInfo_t* info);
 /**
@@ -537,6 +845,25 @@ Coordinate_t get_piece_shifts(int piece, int pos, int num);
  * @see Piece_t
  */
 Piece_t random_piece();
+/**
+ * @brief Draws a piece from a seeded generator.
+ *
+ * Unlike `random_piece`, the function does not use `rand`, so games drawn in
+ * several threads neither contend on its lock nor change its sequence.
+ *
+ * @param rng A pointer to the state of the generator, advanced by the call.
+ * @return Piece_t A piece with a pseudo-random type and initial position.
+ *
+ * @see next_random
+ */
+Piece_t draw_piece(uint64_t* rng);
+/**
+ * @brief Returns the next number of a SplitMix64 generator.
+ *
+ * @param rng A pointer to the state of the generator, advanced by the call.
+ * @return uint64_t The next pseudo-random number.
+ */
+uint64_t next_random(uint64_t* rng);
 /**
  * @brief Calculates the delay for each game iteration based on the current
  * level.
@@ -572,25 +899,95 @@ int get_level_boundary(int level);
 /**
  * @brief Loads the high score from a file.
  *
- * This function loads the high score from a file specified by `FILE_PATH`. If
- * the file exists and contains a valid integer, the high score is read from the
- * file and returned. If the file does not exist or cannot be read, the function
- * returns 0.
+ * This function loads the high score from a file specified by `FILE_PATH`, or
+ * by `set_high_score_file`. If the file exists and contains a valid integer,
+ * the high score is read from the file and returned. If the file does not exist
+ * or cannot be read, the function returns 0.
  *
  * @return int The high score loaded from the file, or 0 if the file does not
  * exist or cannot be read.
+ *
+ * @see set_high_score_file
  */
 int load_high_score();
 /**
  * @brief Saves the high score to a file.
  *
- * This function saves the high score to a file specified by `FILE_PATH`.
+ * This function saves the high score to a file specified by `FILE_PATH`, or
+ * by `set_high_score_file`. While the writer thread is running, the score is
+ * only handed over to it and the function returns without any file access;
+ * otherwise the file is written right away with `write_high_score`.
  *
  * @param info A pointer to the `GameInfo_t` structure containing the high score
  * to be saved.
  *
  * @see GameInfo_t
+ * @see set_high_score_file
+ * @see start_high_score_writer
  */
 void save_high_score(GameInfo_t* info);
+/**
+ * @brief Sets the file the high score is loaded from and saved to.
+ *
+ * Games replayed or simulated in bulk should not touch the player's high
+ * score, so the file can also be disabled. The setting applies to the whole
+ * process and must not be changed while games are being played.
+ *
+ * @param path The path to the high score file, or `NULL` to neither load nor
+ * save the high score.
+ *
+ * @see load_high_score
+ * @see save_high_score
+ */
+void set_high_score_file(const char* path);
+/**
+ * @brief Writes the high score file atomically.
+ *
+ * The score is written to a temporary file next to the high score file,
+ * synced to the disk and renamed over the file, so the file always holds
+ * either the previous or the new score, even after a crash.
+ *
+ * @param path The path to the high score file.
+ * @param high_score The high score to be written.
+ * @return bool `true` if the file has been written, otherwise `false`.
+ */
+bool write_high_score(const char* path, int high_score);
+/**
+ * @brief Starts the thread that saves the high score in the background.
+ *
+ * Once the thread is running, `save_high_score` no longer touches the file
+ * from the game loop. Scores saved within `HIGH_SCORE_COALESCE_MS` of each
+ * other are coalesced into a single write of the highest one.
+ *
+ * @return bool `true` if the thread is running, otherwise `false`.
+ *
+ * @see stop_high_score_writer
+ * @see run_high_score_writer
+ */
+bool start_high_score_writer();
+/**
+ * @brief Stops the high score writer thread.
+ *
+ * A pending score is written before the thread exits, so no record is lost on
+ * a normal exit.
+ *
+ * @return int The number of writes done by the thread.
+ *
+ * @see start_high_score_writer
+ */
+int stop_high_score_writer();
+/**
+ * @brief Body of the high score writer thread.
+ *
+ * The thread sleeps until a score is saved, waits for further scores for
+ * `HIGH_SCORE_COALESCE_MS` and writes the highest one with
+ * `write_high_score` outside of the lock.
+ *
+ * @param arg Unused.
+ * @return void* Always `NULL`.
+ *
+ * @see start_high_score_writer
+ */
+void* run_high_score_writer(void* arg);
 
 #endif
@@ -0,0 +1,138 @@
+/**
+ * @file book.c
+ * @brief Source file for tetris opening book
+ */
+
+#include "book.h"
+
+#include "bot.h"
+
+bool open_book(Book_t *book, const char *path) {
+  bool res = false;
+  *book = (Book_t){NULL, 0, NULL, 0};
+  int fd = open(path, O_RDONLY);
+  if (fd == -1) return res;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(BookHeader_t)) {
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (map != MAP_FAILED) {
+      const BookHeader_t *header = map;
+      size_t count = (st.st_size - sizeof(BookHeader_t)) / sizeof(BookEntry_t);
+      if (memcmp(header->magic, BOOK_MAGIC, sizeof(header->magic)) == 0 &&
+          header->version == BOOK_VERSION && header->count == count) {
+        book->map = map;
+        book->size = st.st_size;
+        book->entries = (const BookEntry_t *)(header + 1);
+        book->count = count;
+        res = true;
+      } else {
+        munmap(map, st.st_size);
+      }
+    }
+  }
+  close(fd);
+  return res;
+}
+
+void close_book(Book_t *book) {
+  if (book->map != NULL) munmap(book->map, book->size);
+  *book = (Book_t){NULL, 0, NULL, 0};
+}
+
+bool lookup_book(const Book_t *book, uint64_t key, Piece_t *placement) {
+  bool res = false;
+  size_t left = 0, right = book->count;
+  while (left < right) {
+    size_t mid = left + (right - left) / 2;
+    if (book->entries[mid].key < key) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+  if (left < book->count && book->entries[left].key == key) {
+    placement->pos = book->entries[left].pos;
+    placement->coords.row = book->entries[left].row;
+    placement->coords.col = book->entries[left].col;
+    res = true;
+  }
+  return res;
+}
+
+int generate_book(const char *path, int depth) {
+  BookEntry_t *entries = NULL;
+  size_t count = 0, capacity = 0;
+  bool ok = true;
+  for (int cur = 1; cur <= PIECE_COUNT && ok && depth > 0; cur++) {
+    Board_t board;
+    init_board(&board, NULL);
+    ok = add_book_entries(&board, cur, depth, &entries, &count, &capacity);
+  }
+  if (ok && count) {
+    qsort(entries, count, sizeof(BookEntry_t), compare_book_entries);
+    size_t unique = 1;
+    for (size_t i = 1; i < count; i++) {
+      if (entries[i].key != entries[unique - 1].key) {
+        entries[unique++] = entries[i];
+      }
+    }
+    count = unique;
+  }
+  char tmp[FILENAME_MAX];
+  ok = ok && snprintf(tmp, sizeof(tmp), "%s.tmp", path) < (int)sizeof(tmp);
+  FILE *file = ok ? fopen(tmp, "wb") : NULL;
+  if (file != NULL) {
+    BookHeader_t header = {BOOK_MAGIC, BOOK_VERSION, (uint32_t)count};
+    ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+         fwrite(entries, sizeof(BookEntry_t), count, file) == count;
+    ok = fclose(file) == 0 && ok && rename(tmp, path) == 0;
+    if (!ok) remove(tmp);
+  } else {
+    ok = false;
+  }
+  free(entries);
+  return ok ? (int)count : -1;
+}
+
+bool add_book_entries(Board_t *board, int cur, int depth,
+                      BookEntry_t **entries, size_t *count, size_t *capacity) {
+  bool res = true;
+  for (int next = 1; next <= PIECE_COUNT && res; next++) {
+    int queue[SEARCH_DEPTH] = {cur, next};
+    Piece_t best;
+    if (search_placement(&board->info, queue, SEARCH_DEPTH, 0, &best) <=
+        LOST_SCORE) {
+      continue;
+    }
+    if (*count == *capacity) {
+      size_t size = *capacity ? *capacity * 2 : 64;
+      BookEntry_t *grown = realloc(*entries, size * sizeof(BookEntry_t));
+      if (grown == NULL) {
+        res = false;
+        break;
+      }
+      *entries = grown;
+      *capacity = size;
+    }
+    (*entries)[(*count)++] = (BookEntry_t){
+        .key = get_position_key(&board->info, cur, next),
+        .pos = best.pos,
+        .row = best.coords.row,
+        .col = best.coords.col,
+    };
+    if (depth > 1) {
+      Board_t child;
+      init_board(&child, &board->info);
+      place_piece(&child.info, best);
+      collapse_full_rows(&child.info);
+      res = add_book_entries(&child, next, depth - 1, entries, count, capacity);
+    }
+  }
+  return res;
+}
+
+int compare_book_entries(const void *a, const void *b) {
+  uint64_t key_a = ((const BookEntry_t *)a)->key;
+  uint64_t key_b = ((const BookEntry_t *)b)->key;
+  return (key_a > key_b) - (key_a < key_b);
+}
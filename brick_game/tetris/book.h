@@ -0,0 +1,118 @@
+/**
+ * @file book.h
+ * @brief Tetris opening book header file
+ */
+
+#ifndef TETRIS_BOOK_H
+#define TETRIS_BOOK_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "backend.h"
+
+/**
+ * @brief Maps an opening book file into memory.
+ *
+ * This function maps the file read-only and checks its header. The entries are
+ * used directly from the mapping, so opening a book does not parse or copy
+ * anything. The file must have been generated on a machine with the same byte
+ * order.
+ *
+ * @param book A pointer to the `Book_t` structure to be initialized.
+ * @param path The path to the opening book file.
+ * @return bool `true` if the book has been opened, otherwise `false`.
+ *
+ * @see Book_t
+ * @see BookHeader_t
+ * @see close_book
+ */
+bool open_book(Book_t* book, const char* path);
+/**
+ * @brief Unmaps an opening book file.
+ *
+ * @param book A pointer to the `Book_t` structure of the opening book.
+ *
+ * @see Book_t
+ * @see open_book
+ */
+void close_book(Book_t* book);
+/**
+ * @brief Looks up the placement for a position in the opening book.
+ *
+ * This function performs a binary search over the sorted entries of the book.
+ * The type of the returned placement is not set, since it is implied by the
+ * position key.
+ *
+ * @param book A pointer to the `Book_t` structure of the opening book.
+ * @param key The position key.
+ * @param placement A pointer to the `Piece_t` structure the placement is
+ * written to.
+ * @return bool `true` if the position has been found, otherwise `false`.
+ *
+ * @see Book_t
+ * @see BookEntry_t
+ * @see get_position_key
+ */
+bool lookup_book(const Book_t* book, uint64_t key, Piece_t* placement);
+/**
+ * @brief Generates an opening book file.
+ *
+ * This function starts from the empty field, searches the best placement for
+ * every pair of current and next piece types, and continues from the resulting
+ * fields with every following piece type, up to the given number of placed
+ * pieces. The entries are sorted by their keys, duplicate positions are
+ * dropped, and the book is written to a temporary file that replaces the
+ * destination only after it has been written completely.
+ *
+ * @param path The path to the opening book file.
+ * @param depth The number of pieces to be placed from the empty field.
+ * @return int The number of entries written, or `-1` on failure.
+ *
+ * @see BookHeader_t
+ * @see BookEntry_t
+ * @see search_placement
+ * @see add_book_entries
+ */
+int generate_book(const char* path, int depth);
+/**
+ * @brief Adds the entries of the positions following a field to a book.
+ *
+ * This function searches the best placement of the current piece for every
+ * next piece type, appends an entry for each position, and recursively adds the
+ * positions following the chosen placements.
+ *
+ * @param board A pointer to the `Board_t` structure containing the game field.
+ * @param cur The type of the current piece.
+ * @param depth The number of pieces still to be placed.
+ * @param entries A pointer to the dynamic array of entries.
+ * @param count A pointer to the number of entries in the array.
+ * @param capacity A pointer to the capacity of the array.
+ * @return bool `true` on success, `false` if memory could not be allocated.
+ *
+ * @see Board_t
+ * @see BookEntry_t
+ * @see search_placement
+ */
+bool add_book_entries(Board_t* board, int cur, int depth,
+                      BookEntry_t** entries, size_t* count, size_t* capacity);
+/**
+ * @brief Compares two opening book entries by their keys.
+ *
+ * @param a A pointer to the first `BookEntry_t` structure.
+ * @param b A pointer to the second `BookEntry_t` structure.
+ * @return int A negative value, zero or a positive value if the first key is
+ * less than, equal to or greater than the second one.
+ *
+ * @see BookEntry_t
+ */
+int compare_book_entries(const void* a, const void* b);
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file bot.c
+ * @brief Source file for tetris bot
+ */
+
+#include "bot.h"
+
+bool choose_placement(ExpandedGameInfo_t *info, const Book_t *book,
+                      Cache_t *cache, Piece_t *target) {
+  bool res = false, erase = false;
+  if (is_piece_on_field(&info->info, info->cur_piece)) {
+    erase = true;
+    remove_piece(&info->info, info->cur_piece);
+  }
+  int queue[SEARCH_DEPTH] = {info->cur_piece.type, info->next_piece.type};
+  uint64_t key = get_position_key(&info->info, queue[0], queue[1]);
+  CacheEntry_t entry;
+  if (book != NULL) {
+    res = lookup_book(book, key, target);
+    if (res) target->type = queue[0];
+  }
+  if (!res && cache != NULL && probe_cache(cache, key, &entry)) {
+    *target = entry.best;
+    res = true;
+  }
+  if (!res) {
+    entry.score =
+        search_placement(&info->info, queue, SEARCH_DEPTH, 0, &entry.best);
+    res = entry.score > LOST_SCORE;
+    if (res) *target = entry.best;
+    if (res && cache != NULL) store_cache(cache, key, &entry);
+  }
+  if (erase) place_piece(&info->info, info->cur_piece);
+  return res;
+}
+
+double search_placement(GameInfo_t *info, const int *queue, int depth,
+                        int lines, Piece_t *best) {
+  double res = LOST_SCORE;
+  Piece_t placements[POS_COUNT * FIELD_COLS];
+  int count = list_placements(info, queue[0], placements);
+  for (int i = 0; i < count; i++) {
+    Board_t board;
+    init_board(&board, info);
+    place_piece(&board.info, placements[i]);
+    int cleared = lines + collapse_full_rows(&board.info);
+    bool lost = false;
+    for (int r = 0; r < 2; r++) {
+      for (int c = 3; c < 7; c++) {
+        if (board.cells[r][c]) lost = true;
+      }
+    }
+    double score = LOST_SCORE;
+    if (!lost && depth > 1) {
+      score = search_placement(&board.info, queue + 1, depth - 1, cleared,
+                               NULL);
+    } else if (!lost) {
+      score = evaluate_field(&board.info, cleared);
+    }
+    if (score > res) {
+      res = score;
+      if (best != NULL) *best = placements[i];
+    }
+  }
+  return res;
+}
+
+int list_placements(GameInfo_t *info, int type, Piece_t *placements) {
+  int count = 0;
+  for (int pos = 0; pos < POS_COUNT; pos++) {
+    for (int col = 0; col < FIELD_COLS; col++) {
+      Piece_t piece = {type, {SPAWN_ROW, col}, pos};
+      while (piece.coords.row < 2 && !can_place(info, piece)) {
+        piece.coords.row++;
+      }
+      if (!can_place(info, piece)) continue;
+      while (can_place(info, piece)) piece.coords.row++;
+      piece.coords.row--;
+      bool repeated = false;
+      for (int i = 0; i < count && !repeated; i++) {
+        repeated = is_same_placement(placements[i], piece);
+      }
+      if (!repeated) placements[count++] = piece;
+    }
+  }
+  return count;
+}
+
+double evaluate_field(GameInfo_t *info, int lines) {
+  int heights[FIELD_COLS];
+  int height = 0, holes = 0, bumpiness = 0;
+  for (int j = 0; j < FIELD_COLS; j++) {
+    heights[j] = 0;
+    for (int i = 0; i < FIELD_ROWS; i++) {
+      if (info->field[i][j] && !heights[j]) {
+        heights[j] = FIELD_ROWS - i;
+      } else if (!info->field[i][j] && heights[j]) {
+        holes++;
+      }
+    }
+    height += heights[j];
+    if (j > 0) bumpiness += abs(heights[j] - heights[j - 1]);
+  }
+  return WEIGHT_HEIGHT * height + WEIGHT_LINES * lines + WEIGHT_HOLES * holes +
+         WEIGHT_BUMPINESS * bumpiness;
+}
+
+uint64_t get_position_key(GameInfo_t *info, int cur, int next) {
+  uint64_t key = 0;
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      if (info->field[i][j]) key ^= get_zobrist_key(i * FIELD_COLS + j);
+    }
+  }
+  key ^= get_zobrist_key(FIELD_ROWS * FIELD_COLS + cur - 1);
+  key ^= get_zobrist_key(FIELD_ROWS * FIELD_COLS + PIECE_COUNT + next - 1);
+  return key;
+}
+
+uint64_t get_zobrist_key(int index) {
+  static uint64_t keys[FIELD_ROWS * FIELD_COLS + 2 * PIECE_COUNT];
+  static bool ready = false;
+  if (!ready) {
+    uint64_t state = ZOBRIST_SEED;
+    for (int i = 0; i < FIELD_ROWS * FIELD_COLS + 2 * PIECE_COUNT; i++) {
+      uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      keys[i] = z ^ (z >> 31);
+    }
+    ready = true;
+  }
+  return keys[index];
+}
+
+void init_board(Board_t *board, GameInfo_t *src) {
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      board->cells[i][j] = src != NULL ? src->field[i][j] : 0;
+    }
+    board->rows[i] = board->cells[i];
+  }
+  board->info = (GameInfo_t){.field = board->rows};
+}
@@ -0,0 +1,151 @@
+/**
+ * @file bot.h
+ * @brief Tetris bot header file
+ */
+
+#ifndef TETRIS_BOT_H
+#define TETRIS_BOT_H
+
+#include "backend.h"
+#include "book.h"
+#include "cache.h"
+#include "finesse.h"
+
+/**
+ * @brief Chooses the placement of the current piece.
+ *
+ * This function chooses where the current piece should be placed, taking the
+ * next piece into account. The opening book is consulted first, then the
+ * evaluation cache, and the search is only started if the position is found in
+ * neither of them. The result of the search is stored in the cache. If the
+ * current piece is on the field, it is temporarily removed to avoid
+ * interference with the search.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game field, the current piece and the next piece.
+ * @param book A pointer to the `Book_t` structure of the opening book, or
+ * `NULL`.
+ * @param cache A pointer to the `Cache_t` structure of the evaluation cache, or
+ * `NULL`.
+ * @param target A pointer to the `Piece_t` structure the chosen placement is
+ * written to.
+ * @return bool `true` if a placement has been chosen, otherwise `false`.
+ *
+ * @see ExpandedGameInfo_t
+ * @see Book_t
+ * @see Cache_t
+ * @see get_position_key
+ * @see lookup_book
+ * @see probe_cache
+ * @see store_cache
+ * @see search_placement
+ */
+bool choose_placement(ExpandedGameInfo_t* info, const Book_t* book,
+                      Cache_t* cache, Piece_t* target);
+/**
+ * @brief Searches the best placement for a queue of pieces.
+ *
+ * This function tries every placement of the first piece of the queue, clears
+ * the full rows and recursively searches the placements of the remaining
+ * pieces. The final fields are rated with `evaluate_field`, and a placement
+ * that leaves cells in the spawn area is rated as lost. The piece being placed
+ * must not be on the field.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @param queue The types of the pieces to be placed, in order.
+ * @param depth The number of pieces in the queue.
+ * @param lines The number of rows cleared before the search.
+ * @param best A pointer to the `Piece_t` structure the best placement of the
+ * first piece is written to, or `NULL`.
+ * @return double The rating of the best placement, or `LOST_SCORE` if there is
+ * no placement that does not lose the game.
+ *
+ * @see GameInfo_t
+ * @see Board_t
+ * @see list_placements
+ * @see collapse_full_rows
+ * @see evaluate_field
+ */
+double search_placement(GameInfo_t* info, const int* queue, int depth,
+                        int lines, Piece_t* best);
+/**
+ * @brief Lists all placements of a piece reachable by a drop from the top.
+ *
+ * This function tries every orientation and column of the piece, skipping
+ * orientations that occupy the same cells as an earlier one, and drops the
+ * piece from the highest row it fits in. The piece must not be on the field.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @param type The type of the piece.
+ * @param placements The array of at least `POS_COUNT * FIELD_COLS` elements
+ * the placements are written to.
+ * @return int The number of placements found.
+ *
+ * @see GameInfo_t
+ * @see Piece_t
+ * @see can_place
+ * @see is_same_placement
+ */
+int list_placements(GameInfo_t* info, int type, Piece_t* placements);
+/**
+ * @brief Rates a game field.
+ *
+ * This function rates the game field by a weighted sum of the total height of
+ * the columns, the number of cleared rows, the number of holes and the
+ * differences between the heights of neighbouring columns. Higher ratings are
+ * better.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @param lines The number of rows cleared to reach the field.
+ * @return double The rating of the game field.
+ *
+ * @see GameInfo_t
+ */
+double evaluate_field(GameInfo_t* info, int lines);
+/**
+ * @brief Computes the key of a position.
+ *
+ * This function combines the Zobrist keys of all occupied cells of the game
+ * field with the keys of the current and next piece types. Colors of the cells
+ * are not taken into account. The current piece must not be on the field.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @param cur The type of the current piece.
+ * @param next The type of the next piece.
+ * @return uint64_t The key of the position.
+ *
+ * @see GameInfo_t
+ * @see get_zobrist_key
+ */
+uint64_t get_position_key(GameInfo_t* info, int cur, int next);
+/**
+ * @brief Returns a Zobrist key.
+ *
+ * This function returns one of the pseudo-random keys used for position
+ * hashing. Keys `0` to `FIELD_ROWS * FIELD_COLS - 1` belong to the cells of the
+ * field in row-major order, and the following `2 * PIECE_COUNT` keys belong to
+ * the types of the current and the next piece. The keys are generated from
+ * `ZOBRIST_SEED` on the first call, so they are the same in every run and can
+ * be stored in files.
+ *
+ * @param index The index of the key.
+ * @return uint64_t The key.
+ */
+uint64_t get_zobrist_key(int index);
+/**
+ * @brief Initializes a board as a copy of a game field.
+ *
+ * @param board A pointer to the `Board_t` structure to be initialized.
+ * @param src A pointer to the `GameInfo_t` structure containing the game field
+ * to be copied, or `NULL` for an empty field.
+ *
+ * @see Board_t
+ * @see GameInfo_t
+ */
+void init_board(Board_t* board, GameInfo_t* src);
+
+#endif
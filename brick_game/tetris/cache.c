@@ -0,0 +1,110 @@
+/**
+ * @file cache.c
+ * @brief Source file for tetris evaluation cache
+ */
+
+#include "cache.h"
+
+bool open_cache(Cache_t *cache, const char *path, size_t slots) {
+  bool res = false;
+  *cache = (Cache_t){NULL, 0, NULL, 0, 0};
+  size_t count = CACHE_BUCKET;
+  while (count < slots) count *= 2;
+  int fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd == -1) return res;
+  struct flock lock = {.l_type = F_WRLCK, .l_whence = SEEK_SET};
+  struct stat st;
+  if (fcntl(fd, F_SETLKW, &lock) == 0 && fstat(fd, &st) == 0) {
+    bool created = st.st_size == 0;
+    size_t size = sizeof(CacheHeader_t) + count * sizeof(CacheSlot_t);
+    if (!created) size = st.st_size;
+    if (size >= sizeof(CacheHeader_t) &&
+        (!created || ftruncate(fd, size) == 0)) {
+      void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (map != MAP_FAILED) {
+        CacheHeader_t *header = map;
+        if (created) {
+          memcpy(header->magic, CACHE_MAGIC, sizeof(header->magic));
+          header->version = CACHE_VERSION;
+          header->count = count;
+        }
+        count = (size - sizeof(CacheHeader_t)) / sizeof(CacheSlot_t);
+        if (memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) == 0 &&
+            header->version == CACHE_VERSION && header->count == count &&
+            count >= CACHE_BUCKET && (count & (count - 1)) == 0) {
+          cache->map = map;
+          cache->size = size;
+          cache->slots = (CacheSlot_t *)(header + 1);
+          cache->count = count;
+          cache->generation = atomic_fetch_add(&header->generation, 1) + 1;
+          res = true;
+        } else {
+          munmap(map, size);
+        }
+      }
+    }
+    lock.l_type = F_UNLCK;
+    fcntl(fd, F_SETLK, &lock);
+  }
+  close(fd);
+  return res;
+}
+
+void close_cache(Cache_t *cache) {
+  if (cache->map != NULL) munmap(cache->map, cache->size);
+  *cache = (Cache_t){NULL, 0, NULL, 0, 0};
+}
+
+bool probe_cache(const Cache_t *cache, uint64_t key, CacheEntry_t *entry) {
+  bool res = false;
+  size_t first = key & (cache->count - 1) & ~(size_t)(CACHE_BUCKET - 1);
+  for (size_t i = first; i < first + CACHE_BUCKET && !res; i++) {
+    uint64_t data = atomic_load(&cache->slots[i].data);
+    uint64_t check = atomic_load(&cache->slots[i].check);
+    if (data && (check ^ data) == key) {
+      unpack_cache_entry(data, entry);
+      res = true;
+    }
+  }
+  return res;
+}
+
+void store_cache(Cache_t *cache, uint64_t key, const CacheEntry_t *entry) {
+  size_t first = key & (cache->count - 1) & ~(size_t)(CACHE_BUCKET - 1);
+  CacheSlot_t *slot = NULL, *empty = NULL, *oldest = NULL;
+  int age = -1;
+  for (size_t i = first; i < first + CACHE_BUCKET && slot == NULL; i++) {
+    uint64_t data = atomic_load(&cache->slots[i].data);
+    uint64_t check = atomic_load(&cache->slots[i].check);
+    if (!data && !check) {
+      if (empty == NULL) empty = &cache->slots[i];
+    } else if ((check ^ data) == key) {
+      slot = &cache->slots[i];
+    } else if ((uint16_t)(cache->generation - (data >> 48)) > age) {
+      age = (uint16_t)(cache->generation - (data >> 48));
+      oldest = &cache->slots[i];
+    }
+  }
+  if (slot == NULL) slot = empty != NULL ? empty : oldest;
+  uint64_t data = pack_cache_entry(entry, cache->generation);
+  atomic_store(&slot->data, data);
+  atomic_store(&slot->check, key ^ data);
+}
+
+uint64_t pack_cache_entry(const CacheEntry_t *entry, uint16_t generation) {
+  uint32_t score;
+  memcpy(&score, &entry->score, sizeof(score));
+  return (uint64_t)score | (uint64_t)(entry->best.coords.row & 0x1f) << 32 |
+         (uint64_t)(entry->best.coords.col & 0xf) << 37 |
+         (uint64_t)(entry->best.pos & 0x3) << 41 |
+         (uint64_t)(entry->best.type & 0x7) << 43 | (uint64_t)generation << 48;
+}
+
+void unpack_cache_entry(uint64_t data, CacheEntry_t *entry) {
+  uint32_t score = (uint32_t)data;
+  memcpy(&entry->score, &score, sizeof(score));
+  entry->best.coords.row = (data >> 32) & 0x1f;
+  entry->best.coords.col = (data >> 37) & 0xf;
+  entry->best.pos = (data >> 41) & 0x3;
+  entry->best.type = (data >> 43) & 0x7;
+}
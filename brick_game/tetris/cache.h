@@ -0,0 +1,112 @@
+/**
+ * @file cache.h
+ * @brief Tetris evaluation cache header file
+ */
+
+#ifndef TETRIS_CACHE_H
+#define TETRIS_CACHE_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "backend.h"
+
+/**
+ * @brief Opens an evaluation cache file, creating it if necessary.
+ *
+ * This function maps the cache file for reading and writing, so that several
+ * processes can share it. A missing or empty file is created with the given
+ * number of slots, rounded up to a power of two; an existing file keeps its
+ * size. The file is locked while it is being created and checked, and every
+ * opening starts a new generation of entries used by the eviction policy.
+ *
+ * @param cache A pointer to the `Cache_t` structure to be initialized.
+ * @param path The path to the cache file.
+ * @param slots The number of slots of a newly created file.
+ * @return bool `true` if the cache has been opened, otherwise `false`.
+ *
+ * @see Cache_t
+ * @see CacheHeader_t
+ * @see close_cache
+ */
+bool open_cache(Cache_t* cache, const char* path, size_t slots);
+/**
+ * @brief Unmaps an evaluation cache file.
+ *
+ * @param cache A pointer to the `Cache_t` structure of the cache.
+ *
+ * @see Cache_t
+ * @see open_cache
+ */
+void close_cache(Cache_t* cache);
+/**
+ * @brief Looks up the evaluation of a position in the cache.
+ *
+ * This function checks the slots of the bucket the key belongs to. Slots are
+ * read without locking and are accepted only if their check word matches the
+ * key, so concurrent updates by other threads or processes are safe.
+ *
+ * @param cache A pointer to the `Cache_t` structure of the cache.
+ * @param key The position key.
+ * @param entry A pointer to the `CacheEntry_t` structure the evaluation is
+ * written to.
+ * @return bool `true` if the position has been found, otherwise `false`.
+ *
+ * @see Cache_t
+ * @see CacheSlot_t
+ * @see CacheEntry_t
+ * @see unpack_cache_entry
+ */
+bool probe_cache(const Cache_t* cache, uint64_t key, CacheEntry_t* entry);
+/**
+ * @brief Stores the evaluation of a position in the cache.
+ *
+ * This function writes the evaluation to the slot of the bucket that already
+ * holds the key, or else to an empty slot, or else to the slot whose entry was
+ * stored the most generations ago. Both words of the slot are updated
+ * atomically, the data word first.
+ *
+ * @param cache A pointer to the `Cache_t` structure of the cache.
+ * @param key The position key.
+ * @param entry A pointer to the `CacheEntry_t` structure containing the
+ * evaluation.
+ *
+ * @see Cache_t
+ * @see CacheSlot_t
+ * @see CacheEntry_t
+ * @see pack_cache_entry
+ */
+void store_cache(Cache_t* cache, uint64_t key, const CacheEntry_t* entry);
+/**
+ * @brief Packs an evaluation into a slot data word.
+ *
+ * The score takes the low 32 bits, followed by 5 bits of the row, 4 bits of the
+ * column, 2 bits of the orientation and 3 bits of the type of the placement.
+ * The generation takes the high 16 bits.
+ *
+ * @param entry A pointer to the `CacheEntry_t` structure to be packed.
+ * @param generation The generation of the entry.
+ * @return uint64_t The packed data word.
+ *
+ * @see CacheEntry_t
+ */
+uint64_t pack_cache_entry(const CacheEntry_t* entry, uint16_t generation);
+/**
+ * @brief Unpacks an evaluation from a slot data word.
+ *
+ * @param data The packed data word.
+ * @param entry A pointer to the `CacheEntry_t` structure the evaluation is
+ * written to.
+ *
+ * @see CacheEntry_t
+ * @see pack_cache_entry
+ */
+void unpack_cache_entry(uint64_t data, CacheEntry_t* entry);
+
+#endif
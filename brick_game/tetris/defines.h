@@ -12,17 +12,97 @@
 
 #define FIELD_ROWS 20
 #define FIELD_COLS 10
+#define FIELD_ROWS_MASK ((1u << FIELD_ROWS) - 1)
+#define FIELD_COLS_MASK ((1u << FIELD_COLS) - 1)
 #define NEXT_ROWS 2
 #define NEXT_COLS 4
 
 #define RIGHT 1
 #define LEFT -1
 
+#define SPAWN_ROW 0
+#define SPAWN_COL 5
+
+#define PATH_MAX_KEYS 64
+
+#define RANDOM_INCREMENT 0x9e3779b97f4a7c15ULL
+
 #define DELAY 10
 #define INIT_SCORE 0
 #define INIT_LEVEL 1
+#define MAX_LEVEL 10
 #define INIT_TIMER 250
 
 #define FILE_PATH "high_score.txt"
+#define HIGH_SCORE_COALESCE_MS 250
+
+#define SEARCH_DEPTH 2
+#define WEIGHT_HEIGHT -0.510066
+#define WEIGHT_LINES 0.760666
+#define WEIGHT_HOLES -0.35663
+#define WEIGHT_BUMPINESS -0.184483
+#define LOST_SCORE -1e9
+
+#define ZOBRIST_SEED 0x7e7215ULL
+
+#define BOOK_PATH "opening_book.bin"
+#define BOOK_MAGIC "TTRSBOOK"
+#define BOOK_VERSION 1
+#define BOOK_DEPTH 3
+
+#define CACHE_PATH "eval_cache.bin"
+#define CACHE_MAGIC "TTRSCACH"
+#define CACHE_VERSION 1
+#define CACHE_SLOTS 65536
+#define CACHE_BUCKET 4
+
+#define PROTOCOL_VERSION 1
+#define PROTOCOL_LINE 512
+#define PROTOCOL_GAMES 64
+
+#define POSITION_TEXT 384
+#define POSITION_SIZE 116
+#define POSITION_MAGIC "TTRSPOSN"
+
+#define ENGINE_VERSION 1
+
+#define REPLAY_MAGIC "TTRSRPLY"
+#define REPLAY_VERSION 1
+#define REPLAY_BUFFER 4096
+#define REPLAY_ACTION_BITS 3
+#define VARINT_MAX 10
+
+#define ARCHIVE_MAGIC "TTRSARCH"
+#define ARCHIVE_VERSION 3
+#define ARCHIVE_INTERVAL 1000
+
+#define SAVE_MAGIC "TTRSSAVE"
+#define SAVE_VERSION 2
+#define RESUME_SLOTS 2
+
+#define LEADERBOARD_PATH "/var/tmp/tetris_leaderboard.bin"
+#define LEADERBOARD_ENV "TETRIS_LEADERBOARD"
+#define LEADERBOARD_MODE 0660
+#define LEADERBOARD_TIMEOUT 500
+#define LEADERBOARD_MAGIC "TTRSLDBD"
+#define LEADERBOARD_VERSION 2
+#define LEADERBOARD_SIZE 10
+#define LEADERBOARD_TAG 16
+
+#define EVENT_SUBSCRIBERS 8
+
+#define REWIND_SIZE 256
+#define REWIND_ROWS 4
+#define REWIND_CELLS (REWIND_ROWS * FIELD_COLS / 2)
+#define REWIND_TICKS (5000 / DELAY)
+
+#define SNAPSHOT_SLOTS 3
+#define SNAPSHOT_SLOT_MASK 3u
+#define SNAPSHOT_FRESH 4u
+
+#define POOL_HUGE_PAGE (2u << 20)
+
+#define PACKED_CELL_BITS 3
+#define PACKED_CELL_MASK 7u
 
 #endif
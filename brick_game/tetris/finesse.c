@@ -0,0 +1,165 @@
+/**
+ * @file finesse.c
+ * @brief Source file for tetris finesse path planner
+ */
+
+#include "finesse.h"
+
+bool find_path(ExpandedGameInfo_t *info, Piece_t target, Path_t *path) {
+  bool res = false, erase = false;
+  path->length = -1;
+  if (info->cur_piece.type != target.type) return res;
+  if (is_piece_on_field(&info->info, info->cur_piece)) {
+    erase = true;
+    remove_piece(&info->info, info->cur_piece);
+  }
+  Piece_t start = info->cur_piece;
+  if (start.coords.row == SPAWN_ROW && start.coords.col == SPAWN_COL &&
+      start.pos == 0 && target.pos >= 0 && target.pos < POS_COUNT &&
+      target.coords.col >= 0 && target.coords.col < FIELD_COLS) {
+    const Path_t *table =
+        get_table_path(target.type, target.pos, target.coords.col);
+    if (table->length >= 0 && follow_path(&info->info, start, table, target)) {
+      *path = *table;
+      res = true;
+    }
+  }
+  if (!res) res = search_path(&info->info, start, target, path);
+  if (erase) place_piece(&info->info, info->cur_piece);
+  return res;
+}
+
+bool search_path(GameInfo_t *info, Piece_t start, Piece_t target,
+                 Path_t *path) {
+  static const UserAction_t keys[] = {Left, Right, Action, Down, Up};
+  int prev[FIELD_ROWS * FIELD_COLS * POS_COUNT];
+  UserAction_t via[FIELD_ROWS * FIELD_COLS * POS_COUNT];
+  int queue[FIELD_ROWS * FIELD_COLS * POS_COUNT];
+  int head = 0, tail = 0, found = -1;
+  bool res = false;
+  path->length = -1;
+  for (int i = 0; i < FIELD_ROWS * FIELD_COLS * POS_COUNT; i++) prev[i] = -2;
+  if (can_place(info, start)) {
+    int index =
+        (start.coords.row * FIELD_COLS + start.coords.col) * POS_COUNT +
+        start.pos;
+    prev[index] = -1;
+    queue[tail++] = index;
+  }
+  while (head < tail && found < 0) {
+    int cur = queue[head++];
+    Piece_t piece = {.type = start.type,
+                     .coords = {cur / POS_COUNT / FIELD_COLS,
+                                cur / POS_COUNT % FIELD_COLS},
+                     .pos = cur % POS_COUNT};
+    if (is_same_placement(piece, target)) found = cur;
+    for (int k = 0; k < (int)(sizeof(keys) / sizeof(keys[0])) && found < 0;
+         k++) {
+      Piece_t next = piece;
+      if (!apply_key(info, &next, keys[k])) continue;
+      int index =
+          (next.coords.row * FIELD_COLS + next.coords.col) * POS_COUNT +
+          next.pos;
+      if (prev[index] == -2) {
+        prev[index] = cur;
+        via[index] = keys[k];
+        queue[tail++] = index;
+      }
+    }
+  }
+  if (found >= 0) {
+    int length = 0;
+    for (int i = found; prev[i] >= 0; i = prev[i]) length++;
+    if (length <= PATH_MAX_KEYS) {
+      path->length = length;
+      for (int i = found; prev[i] >= 0; i = prev[i]) {
+        path->keys[--length] = via[i];
+      }
+      res = true;
+    }
+  }
+  return res;
+}
+
+const Path_t *get_table_path(int type, int pos, int col) {
+  static Path_t table[PIECE_COUNT][POS_COUNT][FIELD_COLS];
+  static bool ready = false;
+  if (!ready) {
+    int cells[FIELD_ROWS][FIELD_COLS] = {{0}};
+    int *rows[FIELD_ROWS];
+    for (int i = 0; i < FIELD_ROWS; i++) rows[i] = cells[i];
+    GameInfo_t empty = {.field = rows};
+    for (int t = 0; t < PIECE_COUNT; t++) {
+      Piece_t spawn = {t + 1, {SPAWN_ROW, SPAWN_COL}, 0};
+      for (int p = 0; p < POS_COUNT; p++) {
+        for (int c = 0; c < FIELD_COLS; c++) {
+          Piece_t target = {t + 1, {0, c}, p};
+          while (target.coords.row < FIELD_ROWS && !can_place(&empty, target))
+            target.coords.row++;
+          Path_t *path = &table[t][p][c];
+          path->length = -1;
+          if (target.coords.row < FIELD_ROWS &&
+              search_path(&empty, spawn, target, path) &&
+              path->length < PATH_MAX_KEYS) {
+            path->keys[path->length++] = Up;
+          }
+        }
+      }
+    }
+    ready = true;
+  }
+  return &table[type - 1][pos][col];
+}
+
+bool follow_path(GameInfo_t *info, Piece_t start, const Path_t *path,
+                 Piece_t target) {
+  bool res = true;
+  for (int i = 0; i < path->length && res; i++) {
+    res = apply_key(info, &start, path->keys[i]);
+  }
+  return res && is_same_placement(start, target);
+}
+
+bool apply_key(GameInfo_t *info, Piece_t *piece, UserAction_t key) {
+  Piece_t next = *piece;
+  switch (key) {
+    case Right:
+      next.coords.col += RIGHT;
+      break;
+    case Left:
+      next.coords.col += LEFT;
+      break;
+    case Up:
+      while (can_place(info, next)) next.coords.row++;
+      next.coords.row--;
+      break;
+    case Down:
+      next.coords.row++;
+      break;
+    case Action:
+      next.pos = (next.pos + 1) % POS_COUNT;
+      break;
+    default:
+      break;
+  }
+  bool res = (next.coords.row != piece->coords.row ||
+              next.coords.col != piece->coords.col || next.pos != piece->pos) &&
+             can_place(info, next);
+  if (res) *piece = next;
+  return res;
+}
+
+bool is_same_placement(Piece_t a, Piece_t b) {
+  bool res = a.type == b.type;
+  for (int i = 0; i < PIECE_SIZE && res; i++) {
+    Coordinate_t shift_a = get_piece_shifts(a.type, a.pos, i);
+    bool found = false;
+    for (int j = 0; j < PIECE_SIZE && !found; j++) {
+      Coordinate_t shift_b = get_piece_shifts(b.type, b.pos, j);
+      found = a.coords.row + shift_a.row == b.coords.row + shift_b.row &&
+              a.coords.col + shift_a.col == b.coords.col + shift_b.col;
+    }
+    res = found;
+  }
+  return res;
+}
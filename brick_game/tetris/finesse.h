@@ -0,0 +1,140 @@
+/**
+ * @file finesse.h
+ * @brief Tetris finesse path planner header file
+ */
+
+#ifndef TETRIS_FINESSE_H
+#define TETRIS_FINESSE_H
+
+#include "backend.h"
+
+/**
+ * @brief Finds the shortest key sequence that brings the current piece to a
+ * target placement.
+ *
+ * This function returns the shortest sequence of user inputs that moves the
+ * current piece to the target placement under the movement rules of the game.
+ * If the current piece is still at its spawn position, the precomputed path for
+ * the empty field is tried first and accepted if every key of it can be
+ * performed on the current field. Otherwise, or if the precomputed path is
+ * obstructed, the path is searched on the current field. If the current piece
+ * is on the field, it is temporarily removed to avoid interference with the
+ * search. Gravity is not taken into account.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game field and the current piece.
+ * @param target The `Piece_t` structure representing the target placement.
+ * @param path A pointer to the `Path_t` structure the key sequence is written
+ * to.
+ * @return bool `true` if the target placement can be reached, otherwise
+ * `false`.
+ *
+ * @see ExpandedGameInfo_t
+ * @see Path_t
+ * @see get_table_path
+ * @see follow_path
+ * @see search_path
+ */
+bool find_path(ExpandedGameInfo_t* info, Piece_t target, Path_t* path);
+/**
+ * @brief Searches the shortest key sequence between two placements of a piece.
+ *
+ * This function performs a breadth-first search over all positions and
+ * orientations of the piece on the game field, where every key press is an
+ * edge. The search stops as soon as a position occupying the same cells as the
+ * target placement is reached, so symmetric orientations of a piece are treated
+ * as equal. The piece must not be placed on the field.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @param start The `Piece_t` structure representing the starting placement.
+ * @param target The `Piece_t` structure representing the target placement.
+ * @param path A pointer to the `Path_t` structure the key sequence is written
+ * to.
+ * @return bool `true` if the target placement can be reached, otherwise
+ * `false`.
+ *
+ * @see GameInfo_t
+ * @see Path_t
+ * @see apply_key
+ * @see is_same_placement
+ */
+bool search_path(GameInfo_t* info, Piece_t start, Piece_t target,
+                 Path_t* path);
+/**
+ * @brief Returns the precomputed path for a placement on the empty field.
+ *
+ * This function returns the shortest key sequence that brings a piece from its
+ * spawn position to the bottom of the empty field in the given orientation and
+ * column. Each path brings the piece to the highest row it fits in and then
+ * drops it, so the last key is always `Up` and the path stays valid on any
+ * field where nothing blocks the way down. The table of paths is computed with
+ * `search_path` on the first call and reused for subsequent calls.
+ *
+ * @param type The type of the piece.
+ * @param pos The orientation of the piece.
+ * @param col The column of the piece.
+ * @return const Path_t* A pointer to the precomputed path. Its length is `-1`
+ * if the placement does not fit on the field.
+ *
+ * @see Path_t
+ * @see search_path
+ */
+const Path_t* get_table_path(int type, int pos, int col);
+/**
+ * @brief Checks whether a key sequence brings a piece to a target placement.
+ *
+ * This function replays the key sequence on the game field, starting from the
+ * given placement. The sequence is rejected if any of its keys cannot be
+ * performed because the piece is blocked, or if the piece does not end up in
+ * the target placement. The piece must not be placed on the field.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @param start The `Piece_t` structure representing the starting placement.
+ * @param path A pointer to the `Path_t` structure containing the key sequence.
+ * @param target The `Piece_t` structure representing the target placement.
+ * @return bool `true` if the sequence reaches the target placement, otherwise
+ * `false`.
+ *
+ * @see GameInfo_t
+ * @see Path_t
+ * @see apply_key
+ * @see is_same_placement
+ */
+bool follow_path(GameInfo_t* info, Piece_t start, const Path_t* path,
+                 Piece_t target);
+/**
+ * @brief Applies a single key press to a piece that is not on the field.
+ *
+ * This function moves, rotates or drops the piece according to the key, using
+ * the same rules as `make_move`. The piece must not be placed on the field.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the game
+ * field.
+ * @param piece A pointer to the `Piece_t` structure representing the piece to
+ * be moved.
+ * @param key The `UserAction_t` representing the key press.
+ * @return bool `true` if the piece has changed its placement, otherwise
+ * `false`.
+ *
+ * @see GameInfo_t
+ * @see Piece_t
+ * @see UserAction_t
+ * @see can_place
+ */
+bool apply_key(GameInfo_t* info, Piece_t* piece, UserAction_t key);
+/**
+ * @brief Checks if two placements of a piece occupy the same cells.
+ *
+ * @param a The `Piece_t` structure representing the first placement.
+ * @param b The `Piece_t` structure representing the second placement.
+ * @return bool `true` if both placements occupy the same cells, otherwise
+ * `false`.
+ *
+ * @see Piece_t
+ * @see get_piece_shifts
+ */
+bool is_same_placement(Piece_t a, Piece_t b);
+
+#endif
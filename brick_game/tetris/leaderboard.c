@@ -0,0 +1,142 @@
+/**
+ * @file leaderboard.c
+ * @brief Source file for the tetris shared leaderboard
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "leaderboard.h"
+
+static pthread_mutex_t leaderboard_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool open_leaderboard(Leaderboard_t *board, const char *path) {
+  bool res = false;
+  board->file = NULL;
+  board->fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW,
+                   LEADERBOARD_MODE);
+  if (board->fd == -1) board->fd = open(path, O_RDWR | O_NOFOLLOW);
+  if (board->fd == -1) return res;
+  struct stat st;
+  if (lock_leaderboard(board)) {
+    size_t size = sizeof(LeaderboardFile_t);
+    bool created = fstat(board->fd, &st) == 0 && S_ISREG(st.st_mode) &&
+                   st.st_size == 0 && ftruncate(board->fd, size) == 0;
+    if (created || (fstat(board->fd, &st) == 0 && S_ISREG(st.st_mode) &&
+                    (size_t)st.st_size == size)) {
+      void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       board->fd, 0);
+      if (map != MAP_FAILED) {
+        LeaderboardFile_t *file = map;
+        if (created) {
+          memcpy(file->magic, LEADERBOARD_MAGIC, sizeof(file->magic));
+          file->version = LEADERBOARD_VERSION;
+          file->size = LEADERBOARD_SIZE;
+        }
+        if (memcmp(file->magic, LEADERBOARD_MAGIC, sizeof(file->magic)) == 0 &&
+            file->version == LEADERBOARD_VERSION &&
+            file->size == LEADERBOARD_SIZE && atomic_load(&file->active) < 2) {
+          board->file = file;
+          res = true;
+        } else {
+          munmap(map, size);
+        }
+      }
+    }
+    unlock_leaderboard(board);
+  }
+  if (!res) {
+    close(board->fd);
+    board->fd = -1;
+  }
+  return res;
+}
+
+const char *get_leaderboard_path() {
+  const char *path = getenv(LEADERBOARD_ENV);
+  return path != NULL && *path != '\0' ? path : LEADERBOARD_PATH;
+}
+
+void close_leaderboard(Leaderboard_t *board) {
+  if (board->file != NULL) {
+    munmap(board->file, sizeof(LeaderboardFile_t));
+    close(board->fd);
+  }
+  board->file = NULL;
+  board->fd = -1;
+}
+
+int submit_score(Leaderboard_t *board, const LeaderEntry_t *entry) {
+  LeaderboardFile_t *file = board->file;
+  LeaderEntry_t entries[LEADERBOARD_SIZE];
+  if (read_leaderboard(board, entries) == LEADERBOARD_SIZE &&
+      !ranks_above(entry, &entries[LEADERBOARD_SIZE - 1]))
+    return -1;
+  if (!lock_leaderboard(board)) return -1;
+  uint32_t active = atomic_load(&file->active);
+  const LeaderTable_t *cur = &file->tables[active];
+  LeaderTable_t *next = &file->tables[1 - active];
+  uint32_t count =
+      cur->count < LEADERBOARD_SIZE ? cur->count : LEADERBOARD_SIZE;
+  uint32_t rank = 0;
+  while (rank < count && !ranks_above(entry, &cur->entries[rank])) rank++;
+  int res = -1;
+  if (rank < LEADERBOARD_SIZE) {
+    atomic_fetch_add(&file->sequence, 1);
+    atomic_thread_fence(memory_order_release);
+    memcpy(next->entries, cur->entries, rank * sizeof(LeaderEntry_t));
+    next->entries[rank] = *entry;
+    next->entries[rank].reserved = 0;
+    next->entries[rank].tag[LEADERBOARD_TAG - 1] = '\0';
+    if (count == LEADERBOARD_SIZE) count--;
+    memcpy(&next->entries[rank + 1], &cur->entries[rank],
+           (count - rank) * sizeof(LeaderEntry_t));
+    next->count = count + 1;
+    atomic_store(&file->active, 1 - active);
+    res = (int)rank;
+  }
+  unlock_leaderboard(board);
+  return res;
+}
+
+int read_leaderboard(const Leaderboard_t *board, LeaderEntry_t *entries) {
+  LeaderboardFile_t *file = board->file;
+  uint32_t count = 0;
+  uint64_t sequence;
+  struct stat st;
+  if (fstat(board->fd, &st) != 0 ||
+      (size_t)st.st_size != sizeof(LeaderboardFile_t))
+    return 0;
+  do {
+    sequence = atomic_load(&file->sequence);
+    const LeaderTable_t *table = &file->tables[atomic_load(&file->active) & 1];
+    count = table->count < LEADERBOARD_SIZE ? table->count : LEADERBOARD_SIZE;
+    memcpy(entries, table->entries, count * sizeof(LeaderEntry_t));
+    atomic_thread_fence(memory_order_acquire);
+  } while (atomic_load(&file->sequence) != sequence);
+  return (int)count;
+}
+
+bool lock_leaderboard(Leaderboard_t *board) {
+  struct flock lock = {.l_type = F_WRLCK, .l_whence = SEEK_SET};
+  struct timespec pause = {.tv_sec = 0, .tv_nsec = 1000000};
+  bool res = false;
+  for (int i = 0; !res && i < LEADERBOARD_TIMEOUT; i++) {
+    if (pthread_mutex_trylock(&leaderboard_mutex) == 0) {
+      res = fcntl(board->fd, F_SETLK, &lock) == 0;
+      if (!res) pthread_mutex_unlock(&leaderboard_mutex);
+    }
+    if (!res) nanosleep(&pause, NULL);
+  }
+  return res;
+}
+
+void unlock_leaderboard(Leaderboard_t *board) {
+  struct flock lock = {.l_type = F_UNLCK, .l_whence = SEEK_SET};
+  fcntl(board->fd, F_SETLK, &lock);
+  pthread_mutex_unlock(&leaderboard_mutex);
+}
+
+bool ranks_above(const LeaderEntry_t *a, const LeaderEntry_t *b) {
+  return a->score > b->score ||
+         (a->score == b->score && a->timestamp < b->timestamp);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file leaderboard.h
+ * @brief Tetris shared leaderboard header file
+ */
+
+#ifndef TETRIS_LEADERBOARD_H
+#define TETRIS_LEADERBOARD_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "backend.h"
+
+/**
+ * @brief Maps a leaderboard file into memory, creating it if needed.
+ *
+ * The file is created and initialized under the leaderboard lock, so
+ * processes opening it at the same time agree on its contents. A new file is
+ * created with the mode `LEADERBOARD_MODE` less the umask, while an existing
+ * file keeps its owner and mode; a symbolic link or a file that is not a
+ * regular file is rejected. The descriptor is kept open for the lock, and the
+ * board is read and updated through the shared mapping.
+ *
+ * @param board A pointer to the `Leaderboard_t` structure to be initialized.
+ * @param path The path to the leaderboard file.
+ * @return bool `true` if the board has been opened, otherwise `false`.
+ *
+ * @see LeaderboardFile_t
+ * @see close_leaderboard
+ */
+bool open_leaderboard(Leaderboard_t* board, const char* path);
+/**
+ * @brief Returns the path to the shared leaderboard file.
+ *
+ * The path is taken from the `LEADERBOARD_ENV` environment variable, or is
+ * `LEADERBOARD_PATH`, outside any working directory, if it is not set.
+ *
+ * @return const char* The path to the leaderboard file.
+ *
+ * @see open_leaderboard
+ */
+const char* get_leaderboard_path();
+/**
+ * @brief Unmaps and closes a leaderboard file.
+ *
+ * @param board A pointer to the `Leaderboard_t` structure to be released.
+ *
+ * @see open_leaderboard
+ */
+void close_leaderboard(Leaderboard_t* board);
+/**
+ * @brief Adds a finished game to the leaderboard.
+ *
+ * Entries are ordered by score, and an earlier game goes first among equal
+ * scores. If the board is full, the game must beat the last entry to get on
+ * it. Scores that cannot make the board are rejected without taking the lock,
+ * and the game is not ranked if the lock cannot be taken in time.
+ *
+ * @param board A pointer to the `Leaderboard_t` structure of the board.
+ * @param entry A pointer to the `LeaderEntry_t` structure of the game.
+ * @return int The rank of the game on the board, starting with 0, or `-1` if
+ * it did not make the board or the board is busy.
+ *
+ * @see lock_leaderboard
+ */
+int submit_score(Leaderboard_t* board, const LeaderEntry_t* entry);
+/**
+ * @brief Copies the current leaderboard.
+ *
+ * The function never blocks writers and never sees a board that is being
+ * written. A file that no longer has the size of the board is read as empty.
+ *
+ * @param board A pointer to the `Leaderboard_t` structure of the board.
+ * @param entries The array of `LEADERBOARD_SIZE` entries the board is copied
+ * to, best first.
+ * @return int The number of entries on the board.
+ */
+int read_leaderboard(const Leaderboard_t* board, LeaderEntry_t* entries);
+/**
+ * @brief Takes the leaderboard lock.
+ *
+ * The lock is an exclusive `fcntl` lock on the file, which the kernel releases
+ * when its owner exits, together with a mutex that excludes the other threads
+ * of the process. The function retries every millisecond and gives up after
+ * `LEADERBOARD_TIMEOUT` attempts.
+ *
+ * @param board A pointer to the `Leaderboard_t` structure of the board.
+ * @return bool `true` if the lock has been taken, `false` on timeout.
+ *
+ * @see unlock_leaderboard
+ */
+bool lock_leaderboard(Leaderboard_t* board);
+/**
+ * @brief Releases the leaderboard lock.
+ *
+ * @param board A pointer to the `Leaderboard_t` structure of the board.
+ *
+ * @see lock_leaderboard
+ */
+void unlock_leaderboard(Leaderboard_t* board);
+/**
+ * @brief Compares two leaderboard entries.
+ *
+ * @param a A pointer to the first `LeaderEntry_t` structure.
+ * @param b A pointer to the second `LeaderEntry_t` structure.
+ * @return bool `true` if the first entry ranks above the second one,
+ * otherwise `false`.
+ */
+bool ranks_above(const LeaderEntry_t* a, const LeaderEntry_t* b);
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * @file notation.c
+ * @brief Source file for tetris position notation
+ */
+
+#include "notation.h"
+
+void capture_position(ExpandedGameInfo_t *info, Position_t *position) {
+  bool erase = false;
+  if (is_piece_on_field(&info->info, info->cur_piece)) {
+    erase = true;
+    remove_piece(&info->info, info->cur_piece);
+  }
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      position->cells[i][j] = info->info.field[i][j];
+    }
+  }
+  if (erase) place_piece(&info->info, info->cur_piece);
+  position->cur = info->cur_piece;
+  position->next = info->next_piece.type;
+  position->score = info->info.score;
+  position->level = info->info.level;
+  position->timer = info->timer;
+}
+
+void restore_position(ExpandedGameInfo_t *info, const Position_t *position) {
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      info->info.field[i][j] = position->cells[i][j];
+    }
+  }
+  info->cur_piece = position->cur;
+  if (can_place(&info->info, info->cur_piece)) {
+    place_piece(&info->info, info->cur_piece);
+  }
+  info->next_piece = (Piece_t){position->next, {SPAWN_ROW, SPAWN_COL}, 0};
+  fill_next_piece(&info->info, info->next_piece);
+  info->info.score = position->score;
+  info->info.level = position->level;
+  info->info.speed = position->level;
+  info->timer = position->timer;
+  mark_all_changed(&info->changes);
+}
+
+int format_position(const Position_t *position, char *text) {
+  static const char digits[] = "0123456789abcdef";
+  char *end = text;
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    int mask = 0;
+    for (int j = 0; j < FIELD_COLS; j++) {
+      if (position->cells[i][j]) mask |= 1 << j;
+    }
+    *end++ = digits[(mask >> 8) & 0xf];
+    *end++ = digits[(mask >> 4) & 0xf];
+    *end++ = digits[mask & 0xf];
+  }
+  *end++ = ' ';
+  char *colors = end;
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      if (position->cells[i][j]) *end++ = '0' + position->cells[i][j];
+    }
+  }
+  if (end == colors) *end++ = '-';
+  end += sprintf(end, " %d:%d:%d:%d %d %d %d %d", position->cur.type,
+                 position->cur.coords.row, position->cur.coords.col,
+                 position->cur.pos, position->next, position->score,
+                 position->level, position->timer);
+  return end - text;
+}
+
+const char *parse_position(const char *text, Position_t *position) {
+  const char *end = text;
+  int masks[FIELD_ROWS] = {0};
+  for (int i = 0; i < FIELD_ROWS && end != NULL; i++) {
+    for (int k = 0; k < 3 && end != NULL; k++) {
+      char c = *end++;
+      int digit = c >= '0' && c <= '9'   ? c - '0'
+                  : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                  : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                         : -1;
+      if (digit < 0) {
+        end = NULL;
+      } else {
+        masks[i] = masks[i] * 16 + digit;
+      }
+    }
+    if (end != NULL && masks[i] >> FIELD_COLS) end = NULL;
+  }
+  if (end != NULL && *end++ != ' ') end = NULL;
+  bool empty = true;
+  for (int i = 0; i < FIELD_ROWS && end != NULL; i++) {
+    for (int j = 0; j < FIELD_COLS && end != NULL; j++) {
+      position->cells[i][j] = 0;
+      if (masks[i] & (1 << j)) {
+        empty = false;
+        if (*end < '1' || *end > '0' + PIECE_COUNT) {
+          end = NULL;
+        } else {
+          position->cells[i][j] = *end++ - '0';
+        }
+      }
+    }
+  }
+  if (end != NULL && empty && *end++ != '-') end = NULL;
+  int *fields[] = {&position->cur.type, &position->cur.coords.row,
+                   &position->cur.coords.col, &position->cur.pos,
+                   &position->next, &position->score,
+                   &position->level, &position->timer};
+  const char separators[] = "  :::    ";
+  for (int i = 0; i < 8 && end != NULL; i++) {
+    if (*end++ != separators[i + 1]) {
+      end = NULL;
+    } else {
+      end = scan_number(end, fields[i]);
+    }
+  }
+  if (end != NULL && !is_valid_position(position)) end = NULL;
+  return end;
+}
+
+void encode_position(const Position_t *position, uint8_t *data) {
+  for (int k = 0; k < FIELD_ROWS * FIELD_COLS / 2; k++) {
+    const uint8_t *cells = &position->cells[0][0];
+    data[k] = (cells[2 * k] & 0xf) | (cells[2 * k + 1] & 0xf) << 4;
+  }
+  uint8_t *tail = data + FIELD_ROWS * FIELD_COLS / 2;
+  tail[0] = position->cur.type;
+  tail[1] = position->cur.coords.row;
+  tail[2] = position->cur.coords.col;
+  tail[3] = position->cur.pos;
+  tail[4] = position->next;
+  tail[5] = position->level;
+  tail[6] = 0;
+  tail[7] = 0;
+  for (int k = 0; k < 4; k++) {
+    tail[8 + k] = (uint32_t)position->score >> (8 * k);
+    tail[12 + k] = (uint32_t)position->timer >> (8 * k);
+  }
+}
+
+bool decode_position(const uint8_t *data, Position_t *position) {
+  for (int k = 0; k < FIELD_ROWS * FIELD_COLS / 2; k++) {
+    uint8_t *cells = &position->cells[0][0];
+    cells[2 * k] = data[k] & 0xf;
+    cells[2 * k + 1] = data[k] >> 4;
+  }
+  const uint8_t *tail = data + FIELD_ROWS * FIELD_COLS / 2;
+  position->cur = (Piece_t){tail[0], {tail[1], tail[2]}, tail[3]};
+  position->next = tail[4];
+  position->level = tail[5];
+  uint32_t score = 0, timer = 0;
+  for (int k = 0; k < 4; k++) {
+    score |= (uint32_t)tail[8 + k] << (8 * k);
+    timer |= (uint32_t)tail[12 + k] << (8 * k);
+  }
+  position->score = (int32_t)score;
+  position->timer = (int32_t)timer;
+  return is_valid_position(position);
+}
+
+long load_positions(const char *path, Position_t **positions) {
+  long count = -1;
+  *positions = NULL;
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) return count;
+  long size = -1;
+  if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+  char *buffer = size >= 0 ? malloc(size + 1) : NULL;
+  if (buffer != NULL && fseek(file, 0, SEEK_SET) == 0 &&
+      fread(buffer, 1, size, file) == (size_t)size) {
+    buffer[size] = '\0';
+    long header = sizeof(POSITION_MAGIC) - 1;
+    bool binary = size >= header &&
+                  memcmp(buffer, POSITION_MAGIC, header) == 0;
+    long capacity = binary ? (size - header) / POSITION_SIZE : 1;
+    for (long i = 0; !binary && i < size; i++) capacity += buffer[i] == '\n';
+    bool torn = binary && (size - header) % POSITION_SIZE != 0;
+    *positions = torn ? NULL : malloc((capacity + 1) * sizeof(Position_t));
+    count = *positions != NULL ? 0 : -1;
+    const char *text = buffer;
+    const uint8_t *data = (const uint8_t *)buffer + header;
+    while (count >= 0 && count < capacity) {
+      if (binary) {
+        if (!decode_position(data + count * POSITION_SIZE,
+                             &(*positions)[count])) {
+          count = -1;
+        } else {
+          count++;
+        }
+        continue;
+      }
+      while (*text == '\n' || *text == '\r' || *text == ' ') text++;
+      if (*text == '\0') break;
+      text = parse_position(text, &(*positions)[count]);
+      count = text != NULL ? count + 1 : -1;
+    }
+  }
+  if (count < 0) {
+    free(*positions);
+    *positions = NULL;
+  }
+  free(buffer);
+  fclose(file);
+  return count;
+}
+
+bool is_valid_position(const Position_t *position) {
+  bool res = position->cur.type >= 1 && position->cur.type <= PIECE_COUNT &&
+             position->cur.pos >= 0 && position->cur.pos < POS_COUNT &&
+             position->next >= 1 && position->next <= PIECE_COUNT &&
+             position->level >= INIT_LEVEL && position->level <= MAX_LEVEL &&
+             position->score >= 0;
+  int cells[FIELD_ROWS][FIELD_COLS];
+  int *rows[FIELD_ROWS];
+  GameInfo_t scratch = {.field = rows};
+  for (int i = 0; i < FIELD_ROWS && res; i++) {
+    for (int j = 0; j < FIELD_COLS && res; j++) {
+      res = position->cells[i][j] <= PIECE_COUNT;
+      cells[i][j] = position->cells[i][j];
+    }
+    rows[i] = cells[i];
+  }
+  return res && can_place(&scratch, position->cur);
+}
+
+const char *scan_number(const char *text, int *value) {
+  bool negative = *text == '-';
+  if (negative) text++;
+  if (*text < '0' || *text > '9') return NULL;
+  int number = 0;
+  while (*text >= '0' && *text <= '9') {
+    int digit = *text++ - '0';
+    if (number > (INT_MAX - digit) / 10) return NULL;
+    number = number * 10 + digit;
+  }
+  *value = negative ? -number : number;
+  return text;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file notation.h
+ * @brief Tetris position notation header file
+ */
+
+#ifndef TETRIS_NOTATION_H
+#define TETRIS_NOTATION_H
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "backend.h"
+
+/**
+ * @brief Captures the position of a game.
+ *
+ * The current piece is not counted among the locked cells, even if it is
+ * placed on the field.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param position A pointer to the `Position_t` structure the position is
+ * written to.
+ *
+ * @see ExpandedGameInfo_t
+ * @see Position_t
+ */
+void capture_position(ExpandedGameInfo_t* info, Position_t* position);
+/**
+ * @brief Restores the position of a game.
+ *
+ * This function overwrites the game field, places the current piece on it,
+ * fills the next piece display area and sets the score, level, speed and
+ * timer. The game field and the next piece display area must be allocated.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param position A pointer to the `Position_t` structure containing the
+ * position.
+ *
+ * @see ExpandedGameInfo_t
+ * @see Position_t
+ * @see place_piece
+ * @see fill_next_piece
+ */
+void restore_position(ExpandedGameInfo_t* info, const Position_t* position);
+/**
+ * @brief Writes the textual notation of a position.
+ *
+ * The notation consists of seven fields separated by spaces:
+ *
+ * `<rows> <colors> <type>:<row>:<col>:<pos> <next> <score> <level> <timer>`
+ *
+ * where `<rows>` are twenty three-digit hexadecimal masks of the locked cells,
+ * from the top row to the bottom one, with column 0 in the lowest bit, and
+ * `<colors>` are the piece types of the locked cells in the same order, one
+ * digit per cell, or `-` if there are none. The third field describes the
+ * current piece.
+ *
+ * @param position A pointer to the `Position_t` structure containing the
+ * position.
+ * @param text The buffer the notation is written to, at least `POSITION_TEXT`
+ * characters long.
+ * @return int The length of the notation.
+ *
+ * @see Position_t
+ * @see parse_position
+ */
+int format_position(const Position_t* position, char* text);
+/**
+ * @brief Parses the textual notation of a position.
+ *
+ * The notation is described in `format_position`. Parsing stops after the
+ * last field, so positions can be read one after another from a buffer.
+ *
+ * @param text The text to be parsed.
+ * @param position A pointer to the `Position_t` structure the position is
+ * written to.
+ * @return const char* A pointer to the first character after the notation, or
+ * `NULL` if the text is not a valid notation.
+ *
+ * @see Position_t
+ * @see format_position
+ * @see scan_number
+ */
+const char* parse_position(const char* text, Position_t* position);
+/**
+ * @brief Writes the binary encoding of a position.
+ *
+ * The encoding is `POSITION_SIZE` bytes long. It starts with the piece types of
+ * the cells packed two per byte in row-major order, the first cell in the low
+ * half of the byte, followed by one byte each for the type, row, column and
+ * orientation of the current piece, the type of the next piece and the level,
+ * two zero bytes, and the score and the timer as 32-bit little-endian
+ * integers.
+ *
+ * @param position A pointer to the `Position_t` structure containing the
+ * position.
+ * @param data The buffer of `POSITION_SIZE` bytes the encoding is written to.
+ *
+ * @see Position_t
+ * @see decode_position
+ */
+void encode_position(const Position_t* position, uint8_t* data);
+/**
+ * @brief Reads the binary encoding of a position.
+ *
+ * @param data The buffer of `POSITION_SIZE` bytes containing the encoding.
+ * @param position A pointer to the `Position_t` structure the position is
+ * written to.
+ * @return bool `true` if the encoding describes a valid position, otherwise
+ * `false`.
+ *
+ * @see Position_t
+ * @see encode_position
+ * @see is_valid_position
+ */
+bool decode_position(const uint8_t* data, Position_t* position);
+/**
+ * @brief Loads all positions from a file.
+ *
+ * This function reads the whole file at once and parses it in place. A file
+ * that starts with `POSITION_MAGIC` is read as binary encodings following the
+ * signature, any other file as textual notations, one per line.
+ *
+ * @param path The path to the file.
+ * @param positions A pointer to the array of positions allocated by the
+ * function. It must be freed by the caller.
+ * @return long The number of positions loaded, or `-1` if the file cannot be
+ * read or contains an invalid position.
+ *
+ * @see Position_t
+ * @see parse_position
+ * @see decode_position
+ */
+long load_positions(const char* path, Position_t** positions);
+/**
+ * @brief Checks if a position is consistent.
+ *
+ * This function checks that all piece types and the level, from `INIT_LEVEL`
+ * to `MAX_LEVEL`, are in range, and that every cell of the current piece lies
+ * on an empty cell of the field.
+ *
+ * @param position A pointer to the `Position_t` structure to be checked.
+ * @return bool `true` if the position is valid, otherwise `false`.
+ *
+ * @see Position_t
+ */
+bool is_valid_position(const Position_t* position);
+/**
+ * @brief Reads a decimal integer.
+ *
+ * @param text The text to be read.
+ * @param value A pointer to the integer the value is written to.
+ * @return const char* A pointer to the first character after the number, or
+ * `NULL` if the text does not start with a number or the number does not fit
+ * in an `int`.
+ */
+const char* scan_number(const char* text, int* value);
+
+#endif
@@ -6,6 +6,13 @@
 #ifndef TETRIS_OBJECTS_H
 #define TETRIS_OBJECTS_H
 
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "defines.h"
+
 /**
  * @brief Enumeration representing possible game states.
  *
@@ -106,6 +113,328 @@ typedef struct {
   int pos;             /**< The orientation of the piece. */
 } Piece_t;
 
+/**
+ * @brief Structure representing a sequence of user inputs.
+ *
+ * This structure contains the keys that move a piece from its starting position
+ * to a target placement, in the order they have to be pressed, and the number
+ * of keys in the sequence. A length of `-1` marks a placement that cannot be
+ * reached.
+ *
+ * @see find_path
+ * @see search_path
+ * @see get_table_path
+ */
+typedef struct {
+  UserAction_t keys[PATH_MAX_KEYS]; /**< The keys to be pressed. */
+  int length;                       /**< The number of keys in the sequence. */
+} Path_t;
+
+/**
+ * @brief Enumeration representing the kinds of replies of an external bot.
+ *
+ * @see Reply_t
+ * @see parse_reply
+ */
+typedef enum {
+  Place_reply, /**< The bot chooses the placement of the current piece. */
+  Keys_reply,  /**< The bot sends the keys to be pressed. */
+  Quit_reply   /**< The bot gives up the game. */
+} ReplyKind_t;
+
+/**
+ * @brief Structure representing a reply of an external bot.
+ *
+ * @see parse_reply
+ * @see apply_reply
+ */
+typedef struct {
+  int id;           /**< The identifier of the game the reply belongs to. */
+  ReplyKind_t kind; /**< The kind of the reply. */
+  int pos;          /**< The orientation of the chosen placement. */
+  int col;          /**< The column of the chosen placement. */
+  Path_t keys;      /**< The keys to be pressed. */
+} Reply_t;
+
+/**
+ * @brief Structure representing a full position of a game.
+ *
+ * This structure contains everything needed to continue a game from a given
+ * moment: the locked cells with their piece types, the current piece, the type
+ * of the next piece, the score, the level and the game timer. It has a textual
+ * and a binary encoding used to exchange positions with other tools.
+ *
+ * @see capture_position
+ * @see restore_position
+ * @see format_position
+ * @see parse_position
+ * @see encode_position
+ * @see decode_position
+ */
+typedef struct {
+  uint8_t cells[FIELD_ROWS][FIELD_COLS]; /**< The types of the locked cells. */
+  Piece_t cur;                           /**< The current piece. */
+  int next;                              /**< The type of the next piece. */
+  int score;                             /**< The current score. */
+  int level;                             /**< The current level. */
+  int timer;                             /**< The game timer. */
+} Position_t;
+
+/**
+ * @brief Structure representing a standalone copy of a game field.
+ *
+ * This structure owns the cells of a game field together with the row pointers
+ * and the `GameInfo_t` structure that refer to them, so that the board can be
+ * passed to any function working on a game field. Search functions use it to
+ * try out placements without touching the game itself. Since the structure
+ * points into itself, it must be set up with `init_board` and must not be
+ * copied by value.
+ *
+ * @see init_board
+ * @see search_placement
+ */
+typedef struct {
+  int cells[FIELD_ROWS][FIELD_COLS]; /**< The cells of the game field. */
+  int *rows[FIELD_ROWS];             /**< The row pointers into the cells. */
+  GameInfo_t info; /**< The game information referring to the rows. */
+} Board_t;
+
+/**
+ * @brief Structure representing the header of an opening book file.
+ *
+ * @see open_book
+ * @see generate_book
+ */
+typedef struct {
+  char magic[8];    /**< The file signature, equal to `BOOK_MAGIC`. */
+  uint32_t version; /**< The version of the file layout. */
+  uint32_t count;   /**< The number of entries following the header. */
+} BookHeader_t;
+
+/**
+ * @brief Structure representing a single entry of an opening book.
+ *
+ * The entry maps a position key to the best placement of the current piece in
+ * that position. Entries are stored in the file sorted by their keys.
+ *
+ * @see get_position_key
+ * @see lookup_book
+ */
+typedef struct {
+  uint64_t key;        /**< The position key. */
+  uint8_t pos;         /**< The orientation of the placement. */
+  uint8_t row;         /**< The row of the placement. */
+  uint8_t col;         /**< The column of the placement. */
+  uint8_t reserved[5]; /**< Padding, always zero. */
+} BookEntry_t;
+
+/**
+ * @brief Structure representing an opening book mapped into memory.
+ *
+ * @see open_book
+ * @see close_book
+ * @see lookup_book
+ */
+typedef struct {
+  void *map;                  /**< The mapped file. */
+  size_t size;                /**< The size of the mapped file in bytes. */
+  const BookEntry_t *entries; /**< The sorted entries inside the mapping. */
+  size_t count;               /**< The number of entries. */
+} Book_t;
+
+/**
+ * @brief Structure representing the header of an evaluation cache file.
+ *
+ * @see open_cache
+ */
+typedef struct {
+  char magic[8];    /**< The file signature, equal to `CACHE_MAGIC`. */
+  uint32_t version; /**< The version of the file layout. */
+  uint32_t count;   /**< The number of slots following the header. */
+  _Atomic uint32_t generation; /**< The number of times the file was opened. */
+  uint32_t reserved;           /**< Padding, always zero. */
+} CacheHeader_t;
+
+/**
+ * @brief Structure representing a slot of an evaluation cache.
+ *
+ * The slot stores the packed evaluation together with the position key XORed
+ * with it. A reader accepts the slot only if both words match the key, so a
+ * slot that is being overwritten by another thread or process is never read
+ * half-updated.
+ *
+ * @see probe_cache
+ * @see store_cache
+ */
+typedef struct {
+  _Atomic uint64_t check; /**< The position key XORed with the data. */
+  _Atomic uint64_t data;  /**< The packed evaluation. */
+} CacheSlot_t;
+
+/**
+ * @brief Structure representing an evaluation stored in the cache.
+ *
+ * @see probe_cache
+ * @see store_cache
+ */
+typedef struct {
+  float score;  /**< The rating of the best placement. */
+  Piece_t best; /**< The best placement of the current piece. */
+} CacheEntry_t;
+
+/**
+ * @brief Structure representing an evaluation cache mapped into memory.
+ *
+ * @see open_cache
+ * @see close_cache
+ */
+typedef struct {
+  void *map;           /**< The mapped file. */
+  size_t size;         /**< The size of the mapped file in bytes. */
+  CacheSlot_t *slots;  /**< The slots inside the mapping. */
+  size_t count;        /**< The number of slots. */
+  uint16_t generation; /**< The generation of entries stored by this run. */
+} Cache_t;
+
+/**
+ * @brief Enumeration representing the scalar fields of `GameInfo_t` that can
+ * change.
+ *
+ * The values are bits combined in the `fields` member of `Changes_t`.
+ *
+ * @see Changes_t
+ */
+typedef enum {
+  Score_changed = 1,      /**< The score has changed. */
+  High_score_changed = 2, /**< The high score has changed. */
+  Level_changed = 4,      /**< The level has changed. */
+  Speed_changed = 8,      /**< The speed has changed. */
+  Pause_changed = 16      /**< The pause state has changed. */
+} ChangedField_t;
+
+/**
+ * @brief Structure representing the changes of a game since they were last
+ * reset.
+ *
+ * @see get_changes
+ * @see reset_changes
+ */
+typedef struct {
+  uint32_t rows; /**< The changed rows of the game field, bit `i` for row `i`.
+                  */
+  unsigned fields; /**< The changed scalar fields, a `ChangedField_t` mask. */
+  bool next;       /**< The next piece display area has changed. */
+} Changes_t;
+
+/**
+ * @brief Enumeration representing the events of a game.
+ *
+ * The events are emitted by the engine in this order for every lock: the
+ * piece is locked, the rows it completed are cleared and the level goes up if
+ * the score has reached the next level, then either the next piece spawns or
+ * the game is over. The value passed with each event is given below.
+ *
+ * @see subscribe_events
+ * @see emit_event
+ */
+typedef enum {
+  Piece_locked,  /**< A piece was locked; the value is its type. */
+  Rows_cleared,  /**< Rows were cleared; the value is their number. */
+  Level_up,      /**< The level went up; the value is the new level. */
+  Piece_spawned, /**< The next piece is in play; the value is its type. */
+  Topped_out     /**< The game is over; the value is the final score. */
+} GameEvent_t;
+
+/**
+ * @brief Type of a function handling game events.
+ *
+ * @param context The context the handler was subscribed with.
+ * @param info A pointer to the `GameInfo_t` structure of the game.
+ * @param event The event.
+ * @param value The value of the event.
+ */
+typedef void (*EventHandler_t)(void *context, const GameInfo_t *info,
+                               GameEvent_t event, int value);
+
+/**
+ * @brief Structure representing a subscription to game events.
+ */
+typedef struct {
+  EventHandler_t handler; /**< The function called for the events. */
+  void *context;          /**< The first argument of the handler. */
+  unsigned mask; /**< The events delivered, a mask of `1u << GameEvent_t`. */
+} Subscriber_t;
+
+/**
+ * @brief Structure representing the subscribers to the events of a game.
+ *
+ * @see subscribe_events
+ * @see unsubscribe_events
+ */
+typedef struct {
+  Subscriber_t subscribers[EVENT_SUBSCRIBERS]; /**< The subscriptions. */
+  int count; /**< The number of subscriptions. */
+} EventBus_t;
+
+/**
+ * @brief Structure representing the changes made to the game by one lock.
+ *
+ * Instead of a copy of the board, only what the lock changed is kept: the
+ * piece that was locked, the rows it cleared with their cells packed two per
+ * byte, and the level before the lock. The score and the number of rows are
+ * derived from the number of rows cleared, and the piece queue from the
+ * generator, which can be stepped back.
+ *
+ * @see record_lock
+ * @see undo_lock
+ */
+typedef struct {
+  uint32_t rows;               /**< The mask of the cleared rows. */
+  uint16_t ticks;              /**< The iterations the piece was in play. */
+  int8_t row;                  /**< The row the piece was locked in. */
+  int8_t col;                  /**< The column the piece was locked in. */
+  uint8_t type;                /**< The type of the piece. */
+  uint8_t pos;                 /**< The orientation of the piece. */
+  uint8_t level;               /**< The level before the lock. */
+  uint8_t speed;               /**< The speed before the lock. */
+  uint8_t cells[REWIND_CELLS]; /**< The cleared rows, top to bottom. */
+} RewindDelta_t;
+
+/**
+ * @brief Structure representing the rewind history of a game.
+ *
+ * The history is a ring of the last `REWIND_SIZE` locks. When it is attached
+ * to a game, the engine records every lock and the rows it clears.
+ *
+ * @see rewind_game
+ * @see clear_rewind
+ */
+typedef struct {
+  RewindDelta_t deltas[REWIND_SIZE]; /**< The ring of locks. */
+  int head;                          /**< The index of the newest lock. */
+  int count;                         /**< The number of locks kept. */
+  int ticks;   /**< The iterations the current piece has been in play. */
+  bool locked; /**< Whether the rows of the newest lock are to be recorded. */
+} Rewind_t;
+
+/**
+ * @brief Structure representing the storage of a game field and next piece
+ * display area.
+ *
+ * The cells and the row pointers of both areas live in one block, so a game
+ * needs a single allocation, and a pool of games none at all.
+ *
+ * @see attach_storage
+ * @see GamePool_t
+ */
+typedef struct {
+  int cells[FIELD_ROWS][FIELD_COLS]; /**< The cells of the field. */
+  int preview[NEXT_ROWS][NEXT_COLS]; /**< The cells of the next piece. */
+  int *rows[FIELD_ROWS];             /**< The rows of the field. */
+  int *next[NEXT_ROWS];              /**< The rows of the next piece. */
+  bool pooled;                       /**< Whether the storage is pooled. */
+} GameStorage_t;
+
 /**
  * @brief Structure representing the expanded game information.
  *
@@ -125,6 +454,377 @@ typedef struct {
   int timer;              /**< The game timer. */
   GameState_t state;      /**< The current game state. */
   GameState_t prev_state; /**< The previous game state. */
+  Changes_t changes;      /**< The changes since they were last reset. */
+  int lines;              /**< The number of rows cleared in the game. */
+  uint64_t seed;          /**< The seed the game was created with. */
+  uint64_t rng;           /**< The state of the piece generator. */
+  Rewind_t *rewind;       /**< The rewind history, or `NULL`. */
+  EventBus_t *bus;        /**< The event subscribers, or `NULL`. */
+  GameStorage_t *storage; /**< The storage of the field, or `NULL`. */
 } ExpandedGameInfo_t;
 
+/**
+ * @brief Structure representing the header of a replay file.
+ *
+ * The header identifies the engine and the rules the game was recorded with,
+ * which a replay must match to be played back.
+ *
+ * @see open_recorder
+ * @see load_replay
+ */
+typedef struct {
+  char magic[8];       /**< The file signature, equal to `REPLAY_MAGIC`. */
+  uint64_t seed;       /**< The seed of the recorded game. */
+  uint16_t version;    /**< The version of the file layout. */
+  uint16_t engine;     /**< The version of the engine, `ENGINE_VERSION`. */
+  uint16_t delay;      /**< The duration of a game iteration, `DELAY`. */
+  uint16_t init_timer; /**< The initial game timer, `INIT_TIMER`. */
+  uint16_t init_level; /**< The initial level, `INIT_LEVEL`. */
+  uint8_t rows;        /**< The number of field rows, `FIELD_ROWS`. */
+  uint8_t cols;        /**< The number of field columns, `FIELD_COLS`. */
+  uint32_t reserved;   /**< Zero. */
+} ReplayHeader_t;
+
+/**
+ * @brief Structure representing the final state of a recorded session.
+ *
+ * @see close_recorder
+ * @see run_replay
+ */
+typedef struct {
+  int score;      /**< The final score. */
+  int level;      /**< The final level. */
+  int lines;      /**< The number of rows cleared in the last game. */
+  uint64_t ticks; /**< The number of game iterations played. */
+} ReplaySummary_t;
+
+/**
+ * @brief Enumeration representing the outcomes of a replay verification.
+ *
+ * @see verify_replay
+ */
+typedef enum {
+  Replay_valid,      /**< The replay reproduces its recorded summary. */
+  Replay_mismatch,   /**< The final state differs from the summary. */
+  Replay_incomplete, /**< The replay ends without a summary. */
+  Replay_unreadable  /**< The file is not a replay of this engine. */
+} ReplayStatus_t;
+
+/**
+ * @brief Structure representing a replay being recorded.
+ *
+ * Game iterations are only counted; each action is appended to the buffer as
+ * a single varint holding the number of iterations since the previous action
+ * and the action itself, and the buffer is written to the file when it fills
+ * up.
+ *
+ * @see open_recorder
+ * @see record_ticks
+ * @see record_action
+ */
+typedef struct {
+  int fd;                              /**< The file descriptor. */
+  unsigned char buffer[REPLAY_BUFFER]; /**< The buffer of encoded records. */
+  size_t length;                       /**< The number of buffered bytes. */
+  uint64_t pending; /**< The iterations since the previous action. */
+  uint64_t ticks;   /**< The iterations recorded in total. */
+  bool failed;      /**< A write has failed; the rest is dropped. */
+} Recorder_t;
+
+/**
+ * @brief Structure representing a replay loaded into memory.
+ *
+ * @see load_replay
+ * @see next_replay_event
+ */
+typedef struct {
+  ReplayHeader_t header;   /**< The header of the replay. */
+  unsigned char *data;     /**< The records following the header. */
+  size_t size;             /**< The size of the records in bytes. */
+  size_t offset;           /**< The offset of the next record. */
+  bool complete;           /**< The summary has been read. */
+  ReplaySummary_t summary; /**< The recorded summary, if `complete`. */
+} Replay_t;
+
+/**
+ * @brief Structure representing the header of a replay archive file.
+ *
+ * Only the first `length` bytes of the file are part of the archive. The field
+ * is updated after an appended replay has reached the disk, so a replay whose
+ * append was interrupted is ignored.
+ *
+ * @see create_archive
+ * @see append_archive
+ */
+typedef struct {
+  char magic[8];       /**< The file signature, equal to `ARCHIVE_MAGIC`. */
+  uint64_t length;     /**< The number of committed bytes. */
+  uint16_t version;    /**< The version of the file layout. */
+  uint16_t engine;     /**< The version of the engine, `ENGINE_VERSION`. */
+  uint16_t delay;      /**< The duration of a game iteration, `DELAY`. */
+  uint16_t init_timer; /**< The initial game timer, `INIT_TIMER`. */
+  uint16_t init_level; /**< The initial level, `INIT_LEVEL`. */
+  uint8_t rows;        /**< The number of field rows, `FIELD_ROWS`. */
+  uint8_t cols;        /**< The number of field columns, `FIELD_COLS`. */
+  uint32_t interval;   /**< The game iterations between keyframes. */
+} ArchiveHeader_t;
+
+/**
+ * @brief Structure representing a replay stored in an archive.
+ *
+ * The entry is followed by its keyframes, sorted by iteration, and by the
+ * records of the replay, padded to a multiple of 8 bytes.
+ *
+ * @see append_archive
+ * @see Keyframe_t
+ */
+typedef struct {
+  uint64_t size;           /**< The size of the entry in bytes. */
+  uint64_t seed;           /**< The seed of the recorded game. */
+  uint64_t ticks;          /**< The game iterations up to the last record. */
+  uint64_t events;         /**< The size of the records in bytes. */
+  uint32_t keyframes;      /**< The number of keyframes. */
+  uint32_t complete;       /**< The replay ends with a summary. */
+  ReplaySummary_t summary; /**< The recorded summary, if `complete`. */
+} ArchiveEntry_t;
+
+/**
+ * @brief Structure representing a game field packed for storage.
+ *
+ * The occupancy of each row is kept as a bitboard, one bit per column, and
+ * the colors, the piece types, take `PACKED_CELL_BITS` bits per cell. A board
+ * takes 120 bytes instead of the 960 bytes of the cells and row pointers of a
+ * live game. Saves, and so resume files and archive keyframes, hold the field
+ * in this form, so a game that is not being stepped can be kept as a `Save_t`.
+ *
+ * @see pack_board
+ * @see unpack_board
+ * @see Save_t
+ */
+typedef struct {
+  uint16_t occupied[FIELD_ROWS]; /**< The occupied columns of each row. */
+  uint32_t colors[FIELD_ROWS];   /**< The colors of the cells of each row. */
+} PackedBoard_t;
+
+/**
+ * @brief Structure representing the full game state as a fixed-size blob.
+ *
+ * The blob holds everything needed to continue a game exactly as it would have
+ * gone on: the field, the piece queue, the state of the piece generator, the
+ * timer, both game states, the score and the level. The header identifies the
+ * layout and the rules, and the checksum covers everything after it, so a
+ * torn or foreign blob is never restored.
+ *
+ * @see save_game
+ * @see restore_game
+ */
+typedef struct {
+  char magic[8];                         /**< Equal to `SAVE_MAGIC`. */
+  uint16_t version;                      /**< The version of the layout. */
+  uint16_t engine;                       /**< The version of the engine. */
+  uint8_t rows;                          /**< The number of field rows. */
+  uint8_t cols;                          /**< The number of field columns. */
+  uint16_t reserved;                     /**< Zero. */
+  uint32_t size;                         /**< The size of the blob. */
+  uint32_t checksum;                     /**< The checksum of the rest. */
+  uint64_t sequence;                     /**< The number of the save. */
+  uint64_t seed;                         /**< The seed of the game. */
+  uint64_t rng;                          /**< The state of the generator. */
+  int32_t score;                         /**< The current score. */
+  int32_t high_score;                    /**< The high score. */
+  int32_t level;                         /**< The current level. */
+  int32_t speed;                         /**< The current speed. */
+  int32_t pause;                         /**< The pause state. */
+  int32_t timer;                         /**< The game timer. */
+  int32_t lines;                         /**< The number of rows cleared. */
+  int32_t state;                         /**< The current game state. */
+  int32_t prev_state;                    /**< The previous game state. */
+  int32_t next;                          /**< The type of the next piece. */
+  Piece_t cur;                           /**< The current piece. */
+  PackedBoard_t board;                   /**< The game field, packed. */
+  uint8_t preview[NEXT_ROWS][NEXT_COLS]; /**< The next piece display area. */
+} Save_t;
+
+/**
+ * @brief Structure representing a file the live game is saved to.
+ *
+ * The file holds two save slots written in turns, so the slot that is not
+ * being written always contains a complete save.
+ *
+ * @see open_resume
+ * @see update_resume
+ * @see find_resume
+ */
+typedef struct {
+  Save_t *slots;     /**< The slots inside the mapping. */
+  uint64_t sequence; /**< The number of the newest save. */
+  int current;       /**< The slot of the newest save, or `-1`. */
+} Resume_t;
+
+/**
+ * @brief Structure representing the full game state at a moment of a replay.
+ *
+ * A keyframe is taken after the game iteration `tick` and all the actions
+ * recorded at it. Playback resumes from the record at `offset`, which was
+ * recorded `elapsed` iterations before the keyframe.
+ *
+ * @see build_keyframes
+ * @see seek_archive
+ */
+typedef struct {
+  uint64_t tick;    /**< The game iteration. */
+  uint64_t offset;  /**< The offset of the next record. */
+  uint64_t elapsed; /**< The iterations since the previous record. */
+  Save_t state;     /**< The game state. */
+} Keyframe_t;
+
+/**
+ * @brief Structure representing a replay archive mapped into memory.
+ *
+ * @see open_archive
+ * @see close_archive
+ */
+typedef struct {
+  void *map;                      /**< The mapped file. */
+  size_t size;                    /**< The size of the mapping in bytes. */
+  const ArchiveHeader_t *header;  /**< The header inside the mapping. */
+  const ArchiveEntry_t **entries; /**< The entries inside the mapping. */
+  size_t count;                   /**< The number of entries. */
+} Archive_t;
+
+/**
+ * @brief Structure representing a finished game on the leaderboard.
+ *
+ * @see submit_score
+ * @see read_leaderboard
+ */
+typedef struct {
+  int32_t score;             /**< The final score. */
+  int32_t lines;             /**< The number of rows cleared. */
+  int32_t level;             /**< The final level. */
+  int32_t reserved;          /**< Zero. */
+  int64_t timestamp;         /**< The end of the game, in Unix time. */
+  char tag[LEADERBOARD_TAG]; /**< The player tag, zero-terminated. */
+} LeaderEntry_t;
+
+/**
+ * @brief Structure representing one version of the leaderboard.
+ */
+typedef struct {
+  uint32_t count;                          /**< The number of entries. */
+  uint32_t reserved;                       /**< Zero. */
+  LeaderEntry_t entries[LEADERBOARD_SIZE]; /**< The entries, best first. */
+} LeaderTable_t;
+
+/**
+ * @brief Structure representing the layout of a leaderboard file.
+ *
+ * The file is shared by all processes through a mapping. A writer takes the
+ * `fcntl` lock on the file, writes the new version of the board into the
+ * inactive table and makes it active. If the writer dies, the kernel releases
+ * the lock, and the active table is intact since it is never written to.
+ * Readers take no lock: they copy the active table and retry if an update has
+ * been started meanwhile.
+ *
+ * @see open_leaderboard
+ * @see submit_score
+ * @see read_leaderboard
+ */
+typedef struct {
+  char magic[8];             /**< The file signature, `LEADERBOARD_MAGIC`. */
+  uint32_t version;          /**< The version of the file layout. */
+  uint32_t size;             /**< The capacity, `LEADERBOARD_SIZE`. */
+  uint32_t reserved;         /**< Zero. */
+  _Atomic uint32_t active;   /**< The index of the current table. */
+  _Atomic uint64_t sequence; /**< The number of started updates. */
+  LeaderTable_t tables[2];   /**< The current and the next version. */
+} LeaderboardFile_t;
+
+/**
+ * @brief Structure representing a leaderboard mapped into memory.
+ *
+ * @see open_leaderboard
+ * @see close_leaderboard
+ */
+typedef struct {
+  LeaderboardFile_t *file; /**< The mapped file. */
+  int fd;                  /**< The open file, locked by writers. */
+} Leaderboard_t;
+
+/**
+ * @brief Structure representing a self-contained copy of the game state.
+ *
+ * Unlike `GameInfo_t`, which refers to the live rows of the game field, a
+ * snapshot owns its cells, so it can be read by another thread while the game
+ * goes on and copied by value.
+ *
+ * @see take_snapshot
+ * @see snapshot_info
+ */
+typedef struct {
+  int field[FIELD_ROWS][FIELD_COLS]; /**< The cells of the game field. */
+  int next[NEXT_ROWS][NEXT_COLS];    /**< The next piece display area. */
+  int score;                         /**< The current score of the player. */
+  int high_score;     /**< The highest score achieved in the game. */
+  int level;          /**< The current level of the game. */
+  int speed;          /**< The current speed of the game. */
+  int pause;          /**< The pause state of the game. */
+  GameState_t state;  /**< The current game state. */
+  Changes_t changes;  /**< The changes since the previous snapshot read. */
+} Snapshot_t;
+
+/**
+ * @brief Structure representing a triple buffer of game snapshots.
+ *
+ * One thread publishes snapshots and another one reads the newest of them
+ * without locks: each side owns one slot, and the third slot, holding the
+ * newest published snapshot, is handed over by an atomic exchange of
+ * `latest`. The writer never waits for the reader; if the reader falls behind,
+ * the snapshots in between are dropped and their changes are merged into the
+ * next one.
+ *
+ * @see init_snapshots
+ * @see publish_snapshot
+ * @see acquire_snapshot
+ */
+typedef struct {
+  Snapshot_t slots[SNAPSHOT_SLOTS]; /**< The snapshots. */
+  _Atomic unsigned latest; /**< The slot of the newest snapshot, with the
+                              `SNAPSHOT_FRESH` bit set until it is read. */
+  unsigned back;           /**< The slot owned by the writer. */
+  unsigned front;          /**< The slot owned by the reader. */
+  Changes_t pending; /**< The changes of the newest published snapshot. */
+} SnapshotBuffer_t;
+
+/**
+ * @brief Structure representing a slot of a pool of games.
+ *
+ * @see GamePool_t
+ */
+typedef struct {
+  ExpandedGameInfo_t game; /**< The game, first so a game is its slot. */
+  GameStorage_t storage;   /**< The storage of the field of the game. */
+  int next_free;           /**< The next free slot, or `-1`. */
+} PoolSlot_t;
+
+/**
+ * @brief Structure representing a pool of games.
+ *
+ * The slots are mapped in one block when the pool is created, so acquiring
+ * and releasing a game never calls the allocator. The free slots are kept in
+ * a list threaded through the slots.
+ *
+ * @see create_pool
+ * @see acquire_game
+ * @see release_game
+ */
+typedef struct {
+  PoolSlot_t *slots; /**< The slots of the pool. */
+  size_t size;       /**< The size of the mapping in bytes. */
+  int capacity;      /**< The number of slots. */
+  int used;          /**< The number of games acquired. */
+  int free;          /**< The first free slot, or `-1`. */
+  bool huge;         /**< Whether the slots are backed by huge pages. */
+} GamePool_t;
+
 #endif
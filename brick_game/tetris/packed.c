@@ -0,0 +1,38 @@
+/**
+ * @file packed.c
+ * @brief Source file for tetris packed game storage
+ */
+
+#include "packed.h"
+
+void pack_board(const GameInfo_t *info, PackedBoard_t *board) {
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    board->occupied[i] = 0;
+    board->colors[i] = 0;
+    for (int j = 0; j < FIELD_COLS; j++) {
+      set_packed_cell(board, i, j, info->field[i][j]);
+    }
+  }
+}
+
+void unpack_board(const PackedBoard_t *board, GameInfo_t *info) {
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      info->field[i][j] = get_packed_cell(board, i, j);
+    }
+  }
+}
+
+int get_packed_cell(const PackedBoard_t *board, int row, int col) {
+  return (board->colors[row] >> (col * PACKED_CELL_BITS)) & PACKED_CELL_MASK;
+}
+
+void set_packed_cell(PackedBoard_t *board, int row, int col, int type) {
+  int shift = col * PACKED_CELL_BITS;
+  board->colors[row] &= ~(PACKED_CELL_MASK << shift);
+  board->colors[row] |= ((uint32_t)type & PACKED_CELL_MASK) << shift;
+  if (type)
+    board->occupied[row] |= (uint16_t)(1u << col);
+  else
+    board->occupied[row] &= (uint16_t)~(1u << col);
+}
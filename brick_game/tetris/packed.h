@@ -0,0 +1,54 @@
+/**
+ * @file packed.h
+ * @brief Tetris packed game storage header file
+ */
+
+#ifndef TETRIS_PACKED_H
+#define TETRIS_PACKED_H
+
+#include "backend.h"
+
+/**
+ * @brief Packs a game field.
+ *
+ * @param info A pointer to the `GameInfo_t` structure containing the field.
+ * @param board A pointer to the `PackedBoard_t` structure the field is
+ * written to.
+ *
+ * @see PackedBoard_t
+ * @see unpack_board
+ */
+void pack_board(const GameInfo_t* info, PackedBoard_t* board);
+/**
+ * @brief Unpacks a game field.
+ *
+ * @param board A pointer to the `PackedBoard_t` structure containing the
+ * field.
+ * @param info A pointer to the `GameInfo_t` structure with the field to be
+ * filled.
+ *
+ * @see pack_board
+ */
+void unpack_board(const PackedBoard_t* board, GameInfo_t* info);
+/**
+ * @brief Returns the color of a cell of a packed field.
+ *
+ * @param board A pointer to the `PackedBoard_t` structure of the field.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @return int The piece type the cell is filled with, or `0` if it is empty.
+ */
+int get_packed_cell(const PackedBoard_t* board, int row, int col);
+/**
+ * @brief Sets the color of a cell of a packed field.
+ *
+ * The occupancy of the cell is updated along with its color.
+ *
+ * @param board A pointer to the `PackedBoard_t` structure of the field.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @param type The piece type to fill the cell with, or `0` to empty it.
+ */
+void set_packed_cell(PackedBoard_t* board, int row, int col, int type);
+
+#endif
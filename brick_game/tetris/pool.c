@@ -0,0 +1,76 @@
+/**
+ * @file pool.c
+ * @brief Source file for the tetris game pool
+ */
+
+#include "pool.h"
+
+bool create_pool(GamePool_t *pool, int capacity, bool huge) {
+  void *slots = MAP_FAILED;
+  pool->slots = NULL;
+  pool->size = get_pool_size(capacity, huge);
+  pool->capacity = pool->used = 0;
+  pool->free = -1;
+  pool->huge = false;
+  if (pool->size == 0) return false;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+  if (huge) {
+    slots = mmap(NULL, pool->size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB,
+                 -1, 0);
+    pool->huge = slots != MAP_FAILED;
+  }
+#endif
+  if (slots == MAP_FAILED) {
+    slots = mmap(NULL, pool->size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  }
+  if (slots == MAP_FAILED) return false;
+  pool->slots = slots;
+#ifdef MADV_HUGEPAGE
+  if (huge && !pool->huge) madvise(pool->slots, pool->size, MADV_HUGEPAGE);
+#endif
+  for (int i = 0; i < capacity; i++) {
+    pool->slots[i].storage.pooled = true;
+    pool->slots[i].next_free = i + 1 < capacity ? i + 1 : -1;
+  }
+  pool->capacity = capacity;
+  pool->free = 0;
+  return true;
+}
+
+size_t get_pool_size(int capacity, bool huge) {
+  size_t page = POOL_HUGE_PAGE;
+  if (capacity < 1 || (size_t)capacity > SIZE_MAX / sizeof(PoolSlot_t))
+    return 0;
+  size_t size = (size_t)capacity * sizeof(PoolSlot_t);
+  if (huge && size > SIZE_MAX - (page - 1)) return 0;
+  if (huge) size = (size + page - 1) & ~(page - 1);
+  return size;
+}
+
+void destroy_pool(GamePool_t *pool) {
+  if (pool->slots != NULL) munmap(pool->slots, pool->size);
+  pool->slots = NULL;
+  pool->capacity = pool->used = 0;
+  pool->free = -1;
+}
+
+ExpandedGameInfo_t *acquire_game(GamePool_t *pool, uint64_t seed) {
+  if (pool->free < 0) return NULL;
+  PoolSlot_t *slot = &pool->slots[pool->free];
+  pool->free = slot->next_free;
+  pool->used++;
+  attach_storage(&slot->game, &slot->storage);
+  slot->game.rewind = NULL;
+  slot->game.bus = NULL;
+  init_seeded_game(&slot->game, seed);
+  return &slot->game;
+}
+
+void release_game(GamePool_t *pool, ExpandedGameInfo_t *info) {
+  PoolSlot_t *slot = (PoolSlot_t *)info;
+  exit_game(info);
+  slot->next_free = pool->free;
+  pool->free = (int)(slot - pool->slots);
+  pool->used--;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file pool.h
+ * @brief Tetris game pool header file
+ */
+
+#ifndef TETRIS_POOL_H
+#define TETRIS_POOL_H
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include <stdint.h>
+#include <sys/mman.h>
+
+#include "backend.h"
+
+/**
+ * @brief Creates a pool of games.
+ *
+ * The slots of all games are mapped in one anonymous block and put on the
+ * free list, which touches every page, so the memory is committed up front.
+ * With huge pages requested, the block is first mapped from the reserved huge
+ * pages; if there are none, the kernel is advised to back the regular mapping
+ * with transparent huge pages.
+ *
+ * @param pool A pointer to the `GamePool_t` structure to be initialized.
+ * @param capacity The number of games.
+ * @param huge Whether huge pages are to be used.
+ * @return bool `true` if the pool has been created, otherwise `false`.
+ *
+ * @see GamePool_t
+ * @see destroy_pool
+ */
+bool create_pool(GamePool_t* pool, int capacity, bool huge);
+/**
+ * @brief Returns the size of the mapping of a pool of games.
+ *
+ * With huge pages, the size is rounded up to a multiple of `POOL_HUGE_PAGE`.
+ *
+ * @param capacity The number of games.
+ * @param huge Whether huge pages are to be used.
+ * @return size_t The size in bytes, or `0` if the capacity is not positive or
+ * the size does not fit in a `size_t`.
+ *
+ * @see create_pool
+ */
+size_t get_pool_size(int capacity, bool huge);
+/**
+ * @brief Unmaps a pool of games.
+ *
+ * The games acquired from the pool must not be used afterwards.
+ *
+ * @param pool A pointer to the `GamePool_t` structure to be destroyed.
+ *
+ * @see create_pool
+ */
+void destroy_pool(GamePool_t* pool);
+/**
+ * @brief Takes a free game from a pool and initializes it.
+ *
+ * The game is initialized with `init_seeded_game`, without a rewind history
+ * or event subscribers. Nothing is allocated.
+ *
+ * @param pool A pointer to the `GamePool_t` structure of the pool.
+ * @param seed The seed of the piece generator.
+ * @return ExpandedGameInfo_t* A pointer to the game, or `NULL` if the pool is
+ * exhausted.
+ *
+ * @see release_game
+ */
+ExpandedGameInfo_t* acquire_game(GamePool_t* pool, uint64_t seed);
+/**
+ * @brief Returns a game to its pool.
+ *
+ * The game may have been ended with `exit_game` before. It must not be used
+ * afterwards.
+ *
+ * @param pool A pointer to the `GamePool_t` structure of the pool.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure of a game
+ * acquired from the pool.
+ *
+ * @see acquire_game
+ */
+void release_game(GamePool_t* pool, ExpandedGameInfo_t* info);
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file protocol.c
+ * @brief Source file for tetris external bot protocol
+ */
+
+#include "protocol.h"
+
+int run_protocol(FILE *in, FILE *out, int games) {
+  char line[PROTOCOL_LINE];
+  if (games < 1 || games > PROTOCOL_GAMES) return -1;
+  ExpandedGameInfo_t list[PROTOCOL_GAMES];
+  srand(time(NULL) ^ getpid());
+  fprintf(out, "tetris %d %d\n", PROTOCOL_VERSION, games);
+  fflush(out);
+  bool ready = false;
+  while (!ready && fgets(line, sizeof(line), in) != NULL) {
+    ready = strncmp(line, "ready", 5) == 0;
+  }
+  int active = 0;
+  for (int i = 0; i < games && ready; i++, active++) {
+    start_protocol_game(&list[i]);
+    write_position(out, i + 1, &list[i]);
+  }
+  fflush(out);
+  while (active > 0 && fgets(line, sizeof(line), in) != NULL) {
+    Reply_t reply;
+    int id = parse_reply(line, &reply) ? reply.id : 0;
+    if (id < 1 || id > games || list[id - 1].state == Exit) {
+      fprintf(out, "error %d\n", id);
+      fflush(out);
+      continue;
+    }
+    ExpandedGameInfo_t *game = &list[reply.id - 1];
+    if (reply.kind == Quit_reply) {
+      game->state = Game_over;
+    } else if (!apply_reply(game, &reply)) {
+      fprintf(out, "error %d\n", reply.id);
+    }
+    if (game->state == Game_over) {
+      fprintf(out, "gameover %d %d %d\n", reply.id, game->info.score,
+              game->info.level);
+      exit_game(game);
+      game->state = Exit;
+      active--;
+    } else {
+      write_position(out, reply.id, game);
+    }
+    fflush(out);
+  }
+  for (int i = 0; i < games && ready; i++) {
+    if (list[i].state != Exit) exit_game(&list[i]);
+  }
+  if (!active) fprintf(out, "bye\n");
+  fflush(out);
+  return active ? -1 : 0;
+}
+
+void start_protocol_game(ExpandedGameInfo_t *info) {
+  create_game(info);
+  info->state = Play;
+  info->prev_state = Play;
+}
+
+void write_position(FILE *out, int id, ExpandedGameInfo_t *info) {
+  bool erase = false;
+  if (is_piece_on_field(&info->info, info->cur_piece)) {
+    erase = true;
+    remove_piece(&info->info, info->cur_piece);
+  }
+  fprintf(out, "position %d ", id);
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    int mask = 0;
+    for (int j = 0; j < FIELD_COLS; j++) {
+      if (info->info.field[i][j]) mask |= 1 << j;
+    }
+    fprintf(out, "%03x", mask);
+  }
+  fprintf(out, " %d %d %d %d\n", info->cur_piece.type, info->next_piece.type,
+          info->info.level, info->info.score);
+  if (erase) place_piece(&info->info, info->cur_piece);
+}
+
+bool parse_reply(const char *line, Reply_t *reply) {
+  bool res = false;
+  char kind[16] = "";
+  int length = 0;
+  if (sscanf(line, "%d %15s %n", &reply->id, kind, &length) < 2) return res;
+  const char *rest = line + length;
+  reply->keys.length = 0;
+  if (strcmp(kind, "place") == 0) {
+    reply->kind = Place_reply;
+    res = sscanf(rest, "%d %d", &reply->pos, &reply->col) == 2 &&
+          reply->pos >= 0 && reply->pos < POS_COUNT;
+  } else if (strcmp(kind, "keys") == 0) {
+    reply->kind = Keys_reply;
+    res = true;
+    for (; *rest && !isspace((unsigned char)*rest) && res; rest++) {
+      const char *letters = "LRDAU";
+      const UserAction_t actions[] = {Left, Right, Down, Action, Up};
+      const char *found = strchr(letters, *rest);
+      res = found != NULL && reply->keys.length < PATH_MAX_KEYS;
+      if (res) reply->keys.keys[reply->keys.length++] = actions[found - letters];
+    }
+  } else if (strcmp(kind, "quit") == 0) {
+    reply->kind = Quit_reply;
+    res = true;
+  }
+  return res;
+}
+
+bool apply_reply(ExpandedGameInfo_t *info, const Reply_t *reply) {
+  bool res = true;
+  Path_t path = reply->keys;
+  if (reply->kind == Place_reply) {
+    Piece_t target = {info->cur_piece.type, {SPAWN_ROW, reply->col},
+                      reply->pos};
+    remove_piece(&info->info, info->cur_piece);
+    while (target.coords.row < 2 && !can_place(&info->info, target)) {
+      target.coords.row++;
+    }
+    res = can_place(&info->info, target);
+    if (res) {
+      while (can_place(&info->info, target)) target.coords.row++;
+      target.coords.row--;
+    }
+    place_piece(&info->info, info->cur_piece);
+    res = res && find_path(info, target, &path);
+  }
+  if (res) {
+    for (int i = 0; i < path.length; i++) make_move(info, path.keys[i]);
+    make_move(info, Up);
+    info->timer = 0;
+    process_input(info, -1, false);
+  }
+  return res;
+}
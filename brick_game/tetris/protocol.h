@@ -0,0 +1,107 @@
+/**
+ * @file protocol.h
+ * @brief Tetris external bot protocol header file
+ */
+
+#ifndef TETRIS_PROTOCOL_H
+#define TETRIS_PROTOCOL_H
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "finesse.h"
+
+/**
+ * @brief Runs headless games driven by an external bot.
+ *
+ * This function plays the given number of games at once, exchanging text lines
+ * with a bot over the input and output streams. The engine greets the bot with
+ * `tetris <version> <games>` and waits for `ready`. It then sends a position of
+ * every game:
+ *
+ * `position <id> <rows> <cur> <next> <level> <score>`
+ *
+ * where `<rows>` are twenty three-digit hexadecimal masks of the locked cells,
+ * from the top row to the bottom one, with column 0 in the lowest bit. The bot
+ * may answer the positions in any order and may keep several of them
+ * outstanding. For every reply the engine applies it, locks the piece and sends
+ * the next position of the same game, or `gameover <id> <score> <level>` if the
+ * game has ended. Replies that cannot be applied are answered with
+ * `error <id>` followed by the same position again. A reply to a game that does
+ * not exist or has ended is answered with `error <id>` alone, and a line that
+ * cannot be parsed with `error 0`, so the bot is never left waiting. When all
+ * games have ended, the engine sends `bye`.
+ *
+ * @param in The stream the replies of the bot are read from.
+ * @param out The stream the messages to the bot are written to.
+ * @param games The number of games, from 1 to `PROTOCOL_GAMES`.
+ * @return int `0` if all games have ended, `-1` if the bot has not answered.
+ *
+ * @see start_protocol_game
+ * @see write_position
+ * @see parse_reply
+ * @see apply_reply
+ */
+int run_protocol(FILE* in, FILE* out, int games);
+/**
+ * @brief Starts a headless game.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure to be
+ * initialized.
+ *
+ * @see ExpandedGameInfo_t
+ * @see create_game
+ */
+void start_protocol_game(ExpandedGameInfo_t* info);
+/**
+ * @brief Writes the position of a game to the bot.
+ *
+ * @param out The stream the message is written to.
+ * @param id The identifier of the game.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ *
+ * @see ExpandedGameInfo_t
+ * @see run_protocol
+ */
+void write_position(FILE* out, int id, ExpandedGameInfo_t* info);
+/**
+ * @brief Parses a reply of the bot.
+ *
+ * This function accepts the replies `<id> place <pos> <col>`,
+ * `<id> keys <keys>` and `<id> quit`. The keys are given as letters, `L` and
+ * `R` for moving the piece to the left and right, `D` for moving it down, `A`
+ * for rotating it and `U` for dropping it.
+ *
+ * @param line The line to be parsed.
+ * @param reply A pointer to the `Reply_t` structure the reply is written to.
+ * @return bool `true` if the line is a valid reply, otherwise `false`.
+ *
+ * @see Reply_t
+ * @see ReplyKind_t
+ */
+bool parse_reply(const char* line, Reply_t* reply);
+/**
+ * @brief Applies a reply of the bot to a game.
+ *
+ * This function moves the current piece with the keys of the reply, or with
+ * the shortest key sequence to the chosen placement found by `find_path`. The
+ * piece is then dropped and locked, full rows are cleared and the score is
+ * updated as in a regular game.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param reply A pointer to the `Reply_t` structure containing the reply.
+ * @return bool `true` if the reply has been applied, `false` if the chosen
+ * placement cannot be reached.
+ *
+ * @see ExpandedGameInfo_t
+ * @see Reply_t
+ * @see find_path
+ * @see make_move
+ * @see process_input
+ */
+bool apply_reply(ExpandedGameInfo_t* info, const Reply_t* reply);
+
+#endif
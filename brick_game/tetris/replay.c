@@ -0,0 +1,192 @@
+/**
+ * @file replay.c
+ * @brief Source file for tetris replay recording
+ */
+
+#include "replay.h"
+
+bool open_recorder(Recorder_t *recorder, const char *path, uint64_t seed) {
+  recorder->length = 0;
+  recorder->pending = recorder->ticks = 0;
+  recorder->failed = false;
+  recorder->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  if (recorder->fd == -1) return false;
+  ReplayHeader_t header = {REPLAY_MAGIC, seed,       REPLAY_VERSION,
+                           ENGINE_VERSION, DELAY,    INIT_TIMER,
+                           INIT_LEVEL,     FIELD_ROWS, FIELD_COLS,
+                           0};
+  memcpy(recorder->buffer, &header, sizeof(header));
+  recorder->length = sizeof(header);
+  flush_recorder(recorder);
+  return !recorder->failed;
+}
+
+void record_ticks(Recorder_t *recorder, uint64_t count) {
+  recorder->pending += count;
+  recorder->ticks += count;
+}
+
+void record_action(Recorder_t *recorder, UserAction_t action) {
+  if ((int)action < 0 || action == Terminate) return;
+  if (recorder->length + VARINT_MAX > REPLAY_BUFFER) flush_recorder(recorder);
+  recorder->length += put_varint(recorder->buffer + recorder->length,
+                                 recorder->pending << REPLAY_ACTION_BITS |
+                                     (uint64_t)action);
+  recorder->pending = 0;
+}
+
+bool close_recorder(Recorder_t *recorder, ExpandedGameInfo_t *info) {
+  if (recorder->fd == -1) return false;
+  if (recorder->length + 5 * VARINT_MAX > REPLAY_BUFFER)
+    flush_recorder(recorder);
+  uint64_t values[5] = {recorder->pending << REPLAY_ACTION_BITS | Terminate,
+                        (uint64_t)info->info.score, (uint64_t)info->info.level,
+                        (uint64_t)info->lines, recorder->ticks};
+  for (int i = 0; i < 5; i++) {
+    recorder->length +=
+        put_varint(recorder->buffer + recorder->length, values[i]);
+  }
+  flush_recorder(recorder);
+  bool res = close(recorder->fd) == 0 && !recorder->failed;
+  recorder->fd = -1;
+  return res;
+}
+
+void flush_recorder(Recorder_t *recorder) {
+  size_t done = 0;
+  while (!recorder->failed && done < recorder->length) {
+    ssize_t count =
+        write(recorder->fd, recorder->buffer + done, recorder->length - done);
+    if (count <= 0) recorder->failed = true;
+    if (count > 0) done += count;
+  }
+  recorder->length = 0;
+}
+
+size_t put_varint(unsigned char *buffer, uint64_t value) {
+  size_t count = 0;
+  while (value >= 0x80) {
+    buffer[count++] = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[count++] = (unsigned char)value;
+  return count;
+}
+
+bool get_varint(const unsigned char *buffer, size_t size, size_t *offset,
+                uint64_t *value) {
+  uint64_t res = 0;
+  bool done = false;
+  size_t i = *offset;
+  for (int shift = 0; !done && i < size && shift < 64; shift += 7) {
+    res |= (uint64_t)(buffer[i] & 0x7f) << shift;
+    done = !(buffer[i++] & 0x80);
+  }
+  if (done) {
+    *offset = i;
+    *value = res;
+  }
+  return done;
+}
+
+bool load_replay(Replay_t *replay, const char *path) {
+  bool res = false;
+  *replay = (Replay_t){.data = NULL};
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) return res;
+  ReplayHeader_t *header = &replay->header;
+  if (fread(header, sizeof(*header), 1, file) == 1 &&
+      memcmp(header->magic, REPLAY_MAGIC, sizeof(header->magic)) == 0 &&
+      header->version == REPLAY_VERSION && header->engine == ENGINE_VERSION &&
+      header->delay == DELAY && header->init_timer == INIT_TIMER &&
+      header->init_level == INIT_LEVEL && header->rows == FIELD_ROWS &&
+      header->cols == FIELD_COLS && fseek(file, 0, SEEK_END) == 0) {
+    long end = ftell(file);
+    replay->size = end > (long)sizeof(*header) ? end - sizeof(*header) : 0;
+    replay->data = malloc(replay->size + 1);
+    res = replay->data != NULL &&
+          fseek(file, sizeof(*header), SEEK_SET) == 0 &&
+          fread(replay->data, 1, replay->size, file) == replay->size;
+  }
+  fclose(file);
+  if (!res) free_replay(replay);
+  return res;
+}
+
+void free_replay(Replay_t *replay) {
+  free(replay->data);
+  replay->data = NULL;
+  replay->size = replay->offset = 0;
+}
+
+bool next_replay_event(Replay_t *replay, uint64_t *ticks,
+                       UserAction_t *action) {
+  uint64_t value;
+  if (replay->complete ||
+      !get_varint(replay->data, replay->size, &replay->offset, &value))
+    return false;
+  *ticks = value >> REPLAY_ACTION_BITS;
+  *action = (UserAction_t)(value & ((1u << REPLAY_ACTION_BITS) - 1));
+  if (*action == Terminate) {
+    uint64_t summary[4];
+    bool read = true;
+    for (int i = 0; i < 4 && read; i++) {
+      read = get_varint(replay->data, replay->size, &replay->offset,
+                        &summary[i]);
+    }
+    if (read) {
+      replay->summary = (ReplaySummary_t){(int)summary[0], (int)summary[1],
+                                          (int)summary[2], summary[3]};
+    }
+    replay->complete = read;
+  }
+  return true;
+}
+
+bool run_replay(Replay_t *replay, ExpandedGameInfo_t *info,
+                ReplaySummary_t *result) {
+  create_seeded_game(info, replay->header.seed);
+  uint64_t ticks, total = 0;
+  UserAction_t action;
+  bool running = true;
+  while (running && next_replay_event(replay, &ticks, &action)) {
+    advance_ticks(info, ticks);
+    total += ticks;
+    if (action == Terminate)
+      running = false;
+    else
+      process_action(info, action);
+  }
+  *result = (ReplaySummary_t){info->info.score, info->info.level, info->lines,
+                              total};
+  exit_game(info);
+  return replay->complete;
+}
+
+ReplayStatus_t verify_replay(const char *path, ReplaySummary_t *expected,
+                             ReplaySummary_t *result) {
+  ReplayStatus_t res = Replay_unreadable;
+  Replay_t replay;
+  *expected = *result = (ReplaySummary_t){0, 0, 0, 0};
+  if (load_replay(&replay, path)) {
+    ExpandedGameInfo_t info;
+    res = run_replay(&replay, &info, result) ? Replay_valid : Replay_incomplete;
+    *expected = replay.summary;
+    if (res == Replay_valid &&
+        (expected->score != result->score || expected->level != result->level ||
+         expected->lines != result->lines || expected->ticks != result->ticks))
+      res = Replay_mismatch;
+    free_replay(&replay);
+  }
+  return res;
+}
+
+void advance_ticks(ExpandedGameInfo_t *info, uint64_t count) {
+  while (count > 0) {
+    count -= skip_ticks(info, count > INT32_MAX ? INT32_MAX : (int)count);
+    if (count > 0) {
+      process_input(info, -1, false);
+      count--;
+    }
+  }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file replay.h
+ * @brief Tetris replay recording header file
+ */
+
+#ifndef TETRIS_REPLAY_H
+#define TETRIS_REPLAY_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "backend.h"
+
+/**
+ * @brief Creates a replay file and writes its header.
+ *
+ * The file is truncated and then only appended to. A game played from the
+ * seed with the actions recorded afterwards can be reproduced exactly, since
+ * the engine draws its pieces from the seeded generator and advances its
+ * timers by game iterations only.
+ *
+ * @param recorder A pointer to the `Recorder_t` structure to initialize.
+ * @param path The path to the replay file.
+ * @param seed The seed of the recorded game, see `create_seeded_game`.
+ * @return bool `true` if the file has been created, otherwise `false`.
+ *
+ * @see Recorder_t
+ * @see ReplayHeader_t
+ * @see close_recorder
+ */
+bool open_recorder(Recorder_t* recorder, const char* path, uint64_t seed);
+/**
+ * @brief Counts game iterations applied to the recorded game.
+ *
+ * @param recorder A pointer to the `Recorder_t` structure.
+ * @param count The number of iterations.
+ *
+ * @see Recorder_t
+ */
+void record_ticks(Recorder_t* recorder, uint64_t count);
+/**
+ * @brief Appends a user action applied to the recorded game.
+ *
+ * The action is encoded together with the number of iterations since the
+ * previous one as a single varint, usually of one or two bytes. Actions
+ * without an effect (-1) are not recorded, and the end of the session is
+ * written by `close_recorder`, so `Terminate` is not recorded either.
+ *
+ * @param recorder A pointer to the `Recorder_t` structure.
+ * @param action The `UserAction_t` applied to the game.
+ *
+ * @see Recorder_t
+ * @see put_varint
+ */
+void record_action(Recorder_t* recorder, UserAction_t action);
+/**
+ * @brief Ends the session, writes its summary and closes the replay file.
+ *
+ * @param recorder A pointer to the `Recorder_t` structure.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * final game state.
+ * @return bool `true` if the whole replay has been written, otherwise `false`.
+ *
+ * @see Recorder_t
+ * @see ReplaySummary_t
+ */
+bool close_recorder(Recorder_t* recorder, ExpandedGameInfo_t* info);
+/**
+ * @brief Writes the buffered records to the replay file.
+ *
+ * @param recorder A pointer to the `Recorder_t` structure.
+ *
+ * @see Recorder_t
+ */
+void flush_recorder(Recorder_t* recorder);
+/**
+ * @brief Encodes an unsigned number as a varint.
+ *
+ * Each byte holds seven bits of the number, least significant first, and the
+ * high bit of every byte but the last is set.
+ *
+ * @param buffer The buffer of at least `VARINT_MAX` bytes to write to.
+ * @param value The number to encode.
+ * @return size_t The number of bytes written.
+ */
+size_t put_varint(unsigned char* buffer, uint64_t value);
+/**
+ * @brief Decodes a varint.
+ *
+ * @param buffer The buffer to read from.
+ * @param size The size of the buffer.
+ * @param offset A pointer to the offset to read at, advanced past the varint.
+ * @param value A pointer the decoded number is written to.
+ * @return bool `true` if a whole varint has been read, otherwise `false`.
+ */
+bool get_varint(const unsigned char* buffer, size_t size, size_t* offset,
+                uint64_t* value);
+/**
+ * @brief Reads a replay file into memory.
+ *
+ * @param replay A pointer to the `Replay_t` structure to fill.
+ * @param path The path to the replay file.
+ * @return bool `true` if the file is a replay recorded with the current
+ * engine and rules, otherwise `false`.
+ *
+ * @see Replay_t
+ * @see free_replay
+ */
+bool load_replay(Replay_t* replay, const char* path);
+/**
+ * @brief Frees the memory of a loaded replay.
+ *
+ * @param replay A pointer to the `Replay_t` structure.
+ */
+void free_replay(Replay_t* replay);
+/**
+ * @brief Reads the next recorded action.
+ *
+ * After the final `Terminate` action the summary of the session is read into
+ * the replay, which is then marked as complete.
+ *
+ * @param replay A pointer to the `Replay_t` structure.
+ * @param ticks A pointer the number of iterations before the action is
+ * written to.
+ * @param action A pointer the action is written to.
+ * @return bool `true` if an action has been read, `false` at the end of the
+ * replay or on a damaged record.
+ *
+ * @see Replay_t
+ */
+bool next_replay_event(Replay_t* replay, uint64_t* ticks,
+                       UserAction_t* action);
+/**
+ * @brief Plays a replay back at full speed.
+ *
+ * The game is created from the recorded seed in the given instance, the
+ * recorded iterations and actions are applied to it without any delay, and
+ * the game is freed at the end.
+ *
+ * @param replay A pointer to the `Replay_t` structure, read from its
+ * current position.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure to play in.
+ * @param result A pointer to the `ReplaySummary_t` structure the final state
+ * is written to.
+ * @return bool `true` if the replay is complete, so `result` can be compared
+ * with its summary, otherwise `false`.
+ *
+ * @see Replay_t
+ * @see create_seeded_game
+ * @see advance_ticks
+ */
+bool run_replay(Replay_t* replay, ExpandedGameInfo_t* info,
+                ReplaySummary_t* result);
+/**
+ * @brief Plays a replay file back and compares it with its summary.
+ *
+ * The function is safe to call from several threads at once, provided the
+ * high score file is disabled with `set_high_score_file`.
+ *
+ * @param path The path to the replay file.
+ * @param expected A pointer the recorded summary is written to.
+ * @param result A pointer the summary of the playback is written to.
+ * @return ReplayStatus_t The outcome of the verification.
+ *
+ * @see ReplayStatus_t
+ * @see run_replay
+ */
+ReplayStatus_t verify_replay(const char* path, ReplaySummary_t* expected,
+                             ReplaySummary_t* result);
+/**
+ * @brief Applies a number of game iterations as fast as possible.
+ *
+ * Idle iterations are accounted for with `skip_ticks`, the others are applied
+ * one by one with `process_input`.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param count The number of iterations.
+ *
+ * @see skip_ticks
+ * @see process_input
+ */
+void advance_ticks(ExpandedGameInfo_t* info, uint64_t count);
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file rewind.c
+ * @brief Source file for the tetris rewind history
+ */
+
+#include "rewind.h"
+
+void clear_rewind(Rewind_t *rewind) {
+  rewind->head = REWIND_SIZE - 1;
+  rewind->count = 0;
+  rewind->ticks = 0;
+  rewind->locked = false;
+}
+
+void record_lock(Rewind_t *rewind, const ExpandedGameInfo_t *info) {
+  rewind->head = (rewind->head + 1) % REWIND_SIZE;
+  if (rewind->count < REWIND_SIZE) rewind->count++;
+  RewindDelta_t *delta = &rewind->deltas[rewind->head];
+  delta->rows = 0;
+  delta->ticks = rewind->ticks < UINT16_MAX ? rewind->ticks : UINT16_MAX;
+  delta->row = (int8_t)info->cur_piece.coords.row;
+  delta->col = (int8_t)info->cur_piece.coords.col;
+  delta->type = (uint8_t)info->cur_piece.type;
+  delta->pos = (uint8_t)info->cur_piece.pos;
+  delta->level = (uint8_t)info->info.level;
+  delta->speed = (uint8_t)info->info.speed;
+  rewind->ticks = 0;
+  rewind->locked = true;
+}
+
+void record_rows(Rewind_t *rewind, GameInfo_t *info) {
+  if (!rewind->locked) return;
+  rewind->locked = false;
+  RewindDelta_t *delta = &rewind->deltas[rewind->head];
+  int count = 0;
+  for (int i = 0; i < FIELD_ROWS && count < REWIND_ROWS; i++) {
+    if (!is_row_full(info, i)) continue;
+    delta->rows |= 1u << i;
+    for (int j = 0; j < FIELD_COLS; j++) {
+      int cell = count * FIELD_COLS + j;
+      if (cell % 2 == 0)
+        delta->cells[cell / 2] = (uint8_t)info->field[i][j];
+      else
+        delta->cells[cell / 2] |= (uint8_t)(info->field[i][j] << 4);
+    }
+    count++;
+  }
+}
+
+int rewind_game(ExpandedGameInfo_t *info, int ticks) {
+  Rewind_t *rewind = info->rewind;
+  if (rewind == NULL || (info->state != Play && info->state != Stop))
+    return -1;
+  if (is_piece_on_field(&info->info, info->cur_piece))
+    remove_piece(&info->info, info->cur_piece);
+  int elapsed = rewind->ticks, undone = 0;
+  while (elapsed < ticks && rewind->count > 0) {
+    const RewindDelta_t *delta = &rewind->deltas[rewind->head];
+    undo_lock(info, delta);
+    elapsed += delta->ticks;
+    rewind->head = (rewind->head + REWIND_SIZE - 1) % REWIND_SIZE;
+    rewind->count--;
+    undone++;
+  }
+  info->cur_piece.coords = (Coordinate_t){SPAWN_ROW, SPAWN_COL};
+  info->cur_piece.pos = 0;
+  if (can_place(&info->info, info->cur_piece))
+    place_piece(&info->info, info->cur_piece);
+  info->timer = get_iteration_delay(info->info.level);
+  rewind->ticks = 0;
+  rewind->locked = false;
+  mark_all_changed(&info->changes);
+  return undone;
+}
+
+void undo_lock(ExpandedGameInfo_t *info, const RewindDelta_t *delta) {
+  int **field = info->info.field;
+  int count = 0;
+  for (int i = 0; i < FIELD_ROWS && delta->rows >> i; i++) {
+    if (delta->rows & 1u << i) {
+      for (int j = 0; j < FIELD_COLS; j++) {
+        int cell = count * FIELD_COLS + j;
+        field[i][j] = (delta->cells[cell / 2] >> (cell % 2 * 4)) & 0xf;
+      }
+      count++;
+    } else {
+      int below = 0;
+      for (uint32_t rows = delta->rows >> (i + 1); rows; rows >>= 1) {
+        below += rows & 1;
+      }
+      if (below) {
+        for (int j = 0; j < FIELD_COLS; j++) field[i][j] = field[i + below][j];
+      }
+    }
+  }
+  Piece_t locked = {delta->type, {delta->row, delta->col}, delta->pos};
+  remove_piece(&info->info, locked);
+
+  info->info.score -= get_points(count);
+  info->info.level = delta->level;
+  info->info.speed = delta->speed;
+  info->lines -= count;
+  info->rng -= RANDOM_INCREMENT;
+  info->next_piece = info->cur_piece;
+  info->next_piece.coords = (Coordinate_t){SPAWN_ROW, SPAWN_COL};
+  info->next_piece.pos = 0;
+  info->cur_piece = (Piece_t){delta->type, {SPAWN_ROW, SPAWN_COL}, 0};
+  fill_next_piece(&info->info, info->next_piece);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file rewind.h
+ * @brief Tetris rewind history header file
+ */
+
+#ifndef TETRIS_REWIND_H
+#define TETRIS_REWIND_H
+
+#include "backend.h"
+
+/**
+ * @brief Empties a rewind history.
+ *
+ * @param rewind A pointer to the `Rewind_t` structure to be cleared.
+ *
+ * @see Rewind_t
+ */
+void clear_rewind(Rewind_t* rewind);
+/**
+ * @brief Records a lock in the rewind history.
+ *
+ * The function is called by `make_shift` when the current piece is locked,
+ * before the next piece is taken from the queue. The oldest lock is dropped
+ * if the history is full.
+ *
+ * @param rewind A pointer to the `Rewind_t` structure of the game.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ *
+ * @see record_rows
+ */
+void record_lock(Rewind_t* rewind, const ExpandedGameInfo_t* info);
+/**
+ * @brief Records the rows cleared by the newest lock.
+ *
+ * The function is called by `clear_full_rows` before the full rows are
+ * collapsed, with the current piece removed from the field. It only records
+ * anything right after a lock.
+ *
+ * @param rewind A pointer to the `Rewind_t` structure of the game.
+ * @param info A pointer to the `GameInfo_t` structure containing the field.
+ *
+ * @see record_lock
+ */
+void record_rows(Rewind_t* rewind, GameInfo_t* info);
+/**
+ * @brief Rewinds a game by at least the given number of iterations.
+ *
+ * The current piece is put back at the top, and the newest locks are undone
+ * until the pieces taken back have been in play for the given number of
+ * iterations or the history is exhausted. The game resumes at the moment the
+ * last piece taken back appeared. The high score is kept.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure of the game,
+ * with a rewind history attached.
+ * @param ticks The number of iterations to go back.
+ * @return int The number of locks undone, or `-1` if the game is not being
+ * played.
+ *
+ * @see undo_lock
+ */
+int rewind_game(ExpandedGameInfo_t* info, int ticks);
+/**
+ * @brief Undoes one lock.
+ *
+ * The cleared rows are put back, the cells of the locked piece are removed,
+ * the score, the level and the number of rows are restored, and the piece
+ * queue is stepped back, so the locked piece becomes the current one again at
+ * its spawn position. Only the rows above the lowest cleared row are touched.
+ * The current piece must not be on the field.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure of the game.
+ * @param delta A pointer to the `RewindDelta_t` structure of the lock.
+ *
+ * @see RewindDelta_t
+ */
+void undo_lock(ExpandedGameInfo_t* info, const RewindDelta_t* delta);
+
+#endif
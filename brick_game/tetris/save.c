@@ -0,0 +1,145 @@
+/**
+ * @file save.c
+ * @brief Source file for tetris game state saving
+ */
+
+#include "save.h"
+
+void save_game(const ExpandedGameInfo_t *info, Save_t *save) {
+  *save = (Save_t){.magic = SAVE_MAGIC,
+                   .version = SAVE_VERSION,
+                   .engine = ENGINE_VERSION,
+                   .rows = FIELD_ROWS,
+                   .cols = FIELD_COLS,
+                   .size = sizeof(Save_t),
+                   .seed = info->seed,
+                   .rng = info->rng,
+                   .score = info->info.score,
+                   .high_score = info->info.high_score,
+                   .level = info->info.level,
+                   .speed = info->info.speed,
+                   .pause = info->info.pause,
+                   .timer = info->timer,
+                   .lines = info->lines,
+                   .state = info->state,
+                   .prev_state = info->prev_state,
+                   .next = info->next_piece.type,
+                   .cur = info->cur_piece};
+  pack_board(&info->info, &save->board);
+  for (int i = 0; i < NEXT_ROWS; i++) {
+    for (int j = 0; j < NEXT_COLS; j++) {
+      save->preview[i][j] = (uint8_t)info->info.next[i][j];
+    }
+  }
+  save->checksum = get_save_checksum(save);
+}
+
+bool restore_game(ExpandedGameInfo_t *info, const Save_t *save) {
+  if (!is_valid_save(save)) return false;
+  info->seed = save->seed;
+  info->rng = save->rng;
+  info->info.score = save->score;
+  info->info.high_score = save->high_score;
+  info->info.level = save->level;
+  info->info.speed = save->speed;
+  info->info.pause = save->pause;
+  info->timer = save->timer;
+  info->lines = save->lines;
+  info->state = (GameState_t)save->state;
+  info->prev_state = (GameState_t)save->prev_state;
+  info->cur_piece = save->cur;
+  info->next_piece = (Piece_t){save->next, {SPAWN_ROW, SPAWN_COL}, 0};
+  unpack_board(&save->board, &info->info);
+  for (int i = 0; i < NEXT_ROWS; i++) {
+    for (int j = 0; j < NEXT_COLS; j++) {
+      info->info.next[i][j] = save->preview[i][j];
+    }
+  }
+  mark_all_changed(&info->changes);
+  return true;
+}
+
+bool is_valid_save(const Save_t *save) {
+  bool res =
+      memcmp(save->magic, SAVE_MAGIC, sizeof(save->magic)) == 0 &&
+      save->version == SAVE_VERSION && save->engine == ENGINE_VERSION &&
+      save->rows == FIELD_ROWS && save->cols == FIELD_COLS &&
+      save->size == sizeof(Save_t) &&
+      save->checksum == get_save_checksum(save) && save->state >= -1 &&
+      save->state <= Score_up && save->prev_state >= -1 &&
+      save->prev_state <= Score_up && save->cur.type >= 1 &&
+      save->cur.type <= PIECE_COUNT && save->cur.pos >= 0 &&
+      save->cur.pos < POS_COUNT && save->next >= 1 &&
+      save->next <= PIECE_COUNT;
+  for (int i = 0; i < FIELD_ROWS && res; i++) {
+    res = (save->board.occupied[i] & ~FIELD_COLS_MASK) == 0 &&
+          save->board.colors[i] >> (FIELD_COLS * PACKED_CELL_BITS) == 0;
+    for (int j = 0; j < FIELD_COLS && res; j++) {
+      int type = get_packed_cell(&save->board, i, j);
+      res = type <= PIECE_COUNT &&
+            (type != 0) == (save->board.occupied[i] >> j & 1);
+    }
+  }
+  for (int i = 0; i < PIECE_SIZE && res; i++) {
+    Coordinate_t shift = get_piece_shifts(save->cur.type, save->cur.pos, i);
+    res = !is_beyond_bounds(save->cur.coords.row + shift.row,
+                            save->cur.coords.col + shift.col);
+  }
+  return res;
+}
+
+uint32_t get_save_checksum(const Save_t *save) {
+  const unsigned char *bytes = (const unsigned char *)save;
+  uint32_t hash = 2166136261u;
+  for (size_t i = offsetof(Save_t, sequence); i < sizeof(Save_t); i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+bool open_resume(Resume_t *resume, const char *path) {
+  *resume = (Resume_t){NULL, 0, -1};
+  size_t size = RESUME_SLOTS * sizeof(Save_t);
+  int fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd == -1) return false;
+  struct stat st;
+  bool res = fstat(fd, &st) == 0 &&
+             ((size_t)st.st_size >= size || ftruncate(fd, size) == 0);
+  void *map =
+      res ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : NULL;
+  close(fd);
+  if (map == MAP_FAILED || map == NULL) return false;
+  resume->slots = map;
+  const Save_t *newest = find_resume(resume);
+  if (newest != NULL) {
+    resume->sequence = newest->sequence;
+    resume->current = (int)(newest - resume->slots);
+  }
+  return true;
+}
+
+const Save_t *find_resume(const Resume_t *resume) {
+  const Save_t *res = NULL;
+  for (int i = 0; i < RESUME_SLOTS; i++) {
+    const Save_t *slot = &resume->slots[i];
+    if (is_valid_save(slot) && (res == NULL || slot->sequence > res->sequence))
+      res = slot;
+  }
+  return res;
+}
+
+void update_resume(Resume_t *resume, const ExpandedGameInfo_t *info) {
+  Save_t save;
+  save_game(info, &save);
+  save.sequence = ++resume->sequence;
+  save.checksum = get_save_checksum(&save);
+  resume->current = (resume->current + 1) % RESUME_SLOTS;
+  resume->slots[resume->current] = save;
+}
+
+void close_resume(Resume_t *resume, bool keep) {
+  if (resume->slots == NULL) return;
+  if (!keep) memset(resume->slots, 0, RESUME_SLOTS * sizeof(Save_t));
+  munmap(resume->slots, RESUME_SLOTS * sizeof(Save_t));
+  *resume = (Resume_t){NULL, 0, -1};
+}
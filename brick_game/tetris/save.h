@@ -0,0 +1,127 @@
+/**
+ * @file save.h
+ * @brief Tetris game state saving header file
+ */
+
+#ifndef TETRIS_SAVE_H
+#define TETRIS_SAVE_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "packed.h"
+
+/**
+ * @brief Saves the full state of a game into a blob.
+ *
+ * The sequence number of the blob is set to 0.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param save A pointer to the `Save_t` structure the state is written to.
+ *
+ * @see Save_t
+ * @see restore_game
+ */
+void save_game(const ExpandedGameInfo_t* info, Save_t* save);
+/**
+ * @brief Restores the full state of a game from a blob.
+ *
+ * The game field and the next piece display area must be allocated, for
+ * example by `create_seeded_game`. The game is left untouched if the blob is
+ * not valid. All fields are marked as changed.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure to be restored.
+ * @param save A pointer to the `Save_t` structure containing the state.
+ * @return bool `true` if the state has been restored, otherwise `false`.
+ *
+ * @see Save_t
+ * @see save_game
+ * @see is_valid_save
+ */
+bool restore_game(ExpandedGameInfo_t* info, const Save_t* save);
+/**
+ * @brief Checks if a blob contains a consistent game state.
+ *
+ * This function checks the header against the current layout and rules, the
+ * checksum, that all piece types and game states are in range, that the
+ * occupancy of the packed field matches its colors, and that every cell of
+ * the current piece lies inside the field.
+ *
+ * @param save A pointer to the `Save_t` structure to be checked.
+ * @return bool `true` if the blob can be restored, otherwise `false`.
+ *
+ * @see get_save_checksum
+ */
+bool is_valid_save(const Save_t* save);
+/**
+ * @brief Calculates the checksum of a blob.
+ *
+ * The checksum is the 32-bit FNV-1a hash of all bytes after the `checksum`
+ * field.
+ *
+ * @param save A pointer to the `Save_t` structure.
+ * @return uint32_t The checksum.
+ */
+uint32_t get_save_checksum(const Save_t* save);
+/**
+ * @brief Maps a resume file into memory, creating it if needed.
+ *
+ * The file holds `RESUME_SLOTS` save slots. Since the slots live in a shared
+ * mapping, every save reaches the file as soon as it is written, even if the
+ * process is killed right after.
+ *
+ * @param resume A pointer to the `Resume_t` structure to be initialized.
+ * @param path The path to the resume file.
+ * @return bool `true` if the file has been mapped, otherwise `false`.
+ *
+ * @see Resume_t
+ * @see close_resume
+ */
+bool open_resume(Resume_t* resume, const char* path);
+/**
+ * @brief Finds the newest complete save of a resume file.
+ *
+ * @param resume A pointer to the `Resume_t` structure of the file.
+ * @return const Save_t* A pointer to the newest valid slot, or `NULL` if there
+ * is none.
+ *
+ * @see is_valid_save
+ */
+const Save_t* find_resume(const Resume_t* resume);
+/**
+ * @brief Saves the live game to a resume file.
+ *
+ * The state is saved into a slot other than the one holding the newest save,
+ * so if the process dies while the slot is being written, the newest save is
+ * still there.
+ *
+ * @param resume A pointer to the `Resume_t` structure of the file.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ *
+ * @see save_game
+ * @see find_resume
+ */
+void update_resume(Resume_t* resume, const ExpandedGameInfo_t* info);
+/**
+ * @brief Unmaps a resume file.
+ *
+ * @param resume A pointer to the `Resume_t` structure of the file.
+ * @param keep A boolean indicating whether the saves are kept for the next
+ * run. If it is `false`, the slots are cleared, so a session that ended
+ * normally is not resumed.
+ *
+ * @see open_resume
+ */
+void close_resume(Resume_t* resume, bool keep);
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file snapshot.c
+ * @brief Source file for tetris game snapshots
+ */
+
+#include "snapshot.h"
+
+void init_snapshots(SnapshotBuffer_t *buffer) {
+  memset(buffer->slots, 0, sizeof(buffer->slots));
+  atomic_init(&buffer->latest, 2);
+  buffer->back = 0;
+  buffer->front = 1;
+  buffer->pending = (Changes_t){0, 0, false};
+}
+
+void take_snapshot(ExpandedGameInfo_t *info, Snapshot_t *snapshot) {
+  GameInfo_t *src = &info->info;
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    memcpy(snapshot->field[i], src->field[i], sizeof(snapshot->field[i]));
+  }
+  for (int i = 0; i < NEXT_ROWS; i++) {
+    memcpy(snapshot->next[i], src->next[i], sizeof(snapshot->next[i]));
+  }
+  snapshot->score = src->score;
+  snapshot->high_score = src->high_score;
+  snapshot->level = src->level;
+  snapshot->speed = src->speed;
+  snapshot->pause = src->pause;
+  snapshot->state = info->state;
+  snapshot->changes = get_changes(info);
+}
+
+void publish_snapshot(SnapshotBuffer_t *buffer, ExpandedGameInfo_t *info) {
+  Snapshot_t *snapshot = &buffer->slots[buffer->back];
+  take_snapshot(info, snapshot);
+  reset_changes(info);
+  if (atomic_load_explicit(&buffer->latest, memory_order_acquire) &
+      SNAPSHOT_FRESH)
+    merge_changes(&snapshot->changes, buffer->pending);
+  buffer->pending = snapshot->changes;
+  unsigned prev = atomic_exchange_explicit(
+      &buffer->latest, buffer->back | SNAPSHOT_FRESH, memory_order_acq_rel);
+  buffer->back = prev & SNAPSHOT_SLOT_MASK;
+}
+
+Snapshot_t *acquire_snapshot(SnapshotBuffer_t *buffer) {
+  Snapshot_t *res = NULL;
+  if (atomic_load_explicit(&buffer->latest, memory_order_acquire) &
+      SNAPSHOT_FRESH) {
+    unsigned prev = atomic_exchange_explicit(&buffer->latest, buffer->front,
+                                             memory_order_acq_rel);
+    buffer->front = prev & SNAPSHOT_SLOT_MASK;
+    res = &buffer->slots[buffer->front];
+  }
+  return res;
+}
+
+GameInfo_t snapshot_info(Snapshot_t *snapshot, int *field[FIELD_ROWS],
+                         int *next[NEXT_ROWS]) {
+  for (int i = 0; i < FIELD_ROWS; i++) field[i] = snapshot->field[i];
+  for (int i = 0; i < NEXT_ROWS; i++) next[i] = snapshot->next[i];
+  return (GameInfo_t){field,
+                      next,
+                      snapshot->score,
+                      snapshot->high_score,
+                      snapshot->level,
+                      snapshot->speed,
+                      snapshot->pause};
+}
+
+void merge_changes(Changes_t *changes, Changes_t other) {
+  changes->rows |= other.rows;
+  changes->fields |= other.fields;
+  changes->next = changes->next || other.next;
+}
+
+bool is_unchanged(Changes_t changes) {
+  return !changes.rows && !changes.fields && !changes.next;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file snapshot.h
+ * @brief Tetris game snapshots header file
+ */
+
+#ifndef TETRIS_SNAPSHOT_H
+#define TETRIS_SNAPSHOT_H
+
+#include <string.h>
+
+#include "backend.h"
+
+/**
+ * @brief Initializes an empty triple buffer of snapshots.
+ *
+ * @param buffer A pointer to the `SnapshotBuffer_t` structure to initialize.
+ *
+ * @see SnapshotBuffer_t
+ */
+void init_snapshots(SnapshotBuffer_t* buffer);
+/**
+ * @brief Copies the game state and its changes into a snapshot.
+ *
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param snapshot A pointer to the `Snapshot_t` structure to fill.
+ *
+ * @see Snapshot_t
+ * @see get_changes
+ */
+void take_snapshot(ExpandedGameInfo_t* info, Snapshot_t* snapshot);
+/**
+ * @brief Publishes a snapshot of the game state and resets its changes.
+ *
+ * The snapshot is taken into the slot owned by the writer, which is then
+ * exchanged with the newest one. If the reader has not read the previous
+ * snapshot yet, its changes are carried over to the new one, so the reader
+ * always gets at least all the changes since its last read. Only one thread may
+ * publish to a buffer.
+ *
+ * @param buffer A pointer to the `SnapshotBuffer_t` structure.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ *
+ * @see SnapshotBuffer_t
+ * @see take_snapshot
+ * @see reset_changes
+ */
+void publish_snapshot(SnapshotBuffer_t* buffer, ExpandedGameInfo_t* info);
+/**
+ * @brief Takes over the newest published snapshot.
+ *
+ * The returned snapshot stays valid and unchanged until the next call. Only
+ * one thread may read from a buffer.
+ *
+ * @param buffer A pointer to the `SnapshotBuffer_t` structure.
+ * @return Snapshot_t* The newest snapshot, or `NULL` if nothing has been
+ * published since the last call.
+ *
+ * @see SnapshotBuffer_t
+ */
+Snapshot_t* acquire_snapshot(SnapshotBuffer_t* buffer);
+/**
+ * @brief Returns the game information referring to the cells of a snapshot.
+ *
+ * @param snapshot A pointer to the `Snapshot_t` structure.
+ * @param field The array to fill with the pointers to the field rows.
+ * @param next The array to fill with the pointers to the next piece rows.
+ * @return GameInfo_t The game information, valid as long as the snapshot and
+ * the arrays are.
+ *
+ * @see Snapshot_t
+ */
+GameInfo_t snapshot_info(Snapshot_t* snapshot, int* field[FIELD_ROWS],
+                         int* next[NEXT_ROWS]);
+/**
+ * @brief Adds changes to a change set.
+ *
+ * @param changes A pointer to the `Changes_t` structure to add to.
+ * @param other The changes to add.
+ *
+ * @see Changes_t
+ */
+void merge_changes(Changes_t* changes, Changes_t other);
+/**
+ * @brief Checks whether a change set is empty.
+ *
+ * @param changes The `Changes_t` structure to check.
+ * @return bool `true` if nothing has changed, otherwise `false`.
+ */
+bool is_unchanged(Changes_t changes);
+
+#endif
@@ -0,0 +1,305 @@
+/**
+ * @file ansi.c
+ * @brief Source file for tetris raw ANSI renderer
+ */
+
+#include "ansi.h"
+
+int init_screen(Screen_t *screen, bool show_stats, bool half) {
+  screen->length = 0;
+  screen->row = screen->col = 0;
+  screen->fg = screen->bg = -2;
+  screen->valid = false;
+  screen->shown = false;
+  screen->half = half;
+  screen->truecolor = detect_truecolor();
+  screen->stats = (FrameStats_t){0, 0, 0, 0, 0, 0, 0};
+  screen->show_stats = show_stats;
+  if (!isatty(STDOUT_FILENO) || tcgetattr(STDIN_FILENO, &screen->saved))
+    return -1;
+  struct termios raw = screen->saved;
+  raw.c_lflag &= ~(ICANON | ECHO);
+  raw.c_cc[VMIN] = 1;
+  raw.c_cc[VTIME] = 0;
+  tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
+  begin_frame(screen);
+  append_frame(screen, "\x1b[?1049h\x1b[?25l\x1b[0m");
+  flush_frame(screen);
+  screen->stats = (FrameStats_t){0, 0, 0, 0, 0, 0, 0};
+  return 0;
+}
+
+void close_screen(Screen_t *screen) {
+  begin_frame(screen);
+  append_frame(screen, "\x1b[0m\x1b[?25h\x1b[?1049l");
+  FrameStats_t stats = screen->stats;
+  flush_frame(screen);
+  tcsetattr(STDIN_FILENO, TCSAFLUSH, &screen->saved);
+  if (screen->show_stats) print_stats(stderr, &stats);
+}
+
+void render_game(Screen_t *screen, GameInfo_t info, Changes_t changes) {
+  int width = screen->half ? FIELD_COLS : FIELD_COLS * 2;
+  int height = screen->half ? FIELD_ROWS / 2 : FIELD_ROWS;
+  int panel = ANSI_LEFT + width + 3;
+  begin_frame(screen);
+  if (!screen->valid) {
+    set_color(screen, -1, -1);
+    append_frame(screen, "\x1b[2J");
+    char line[FIELD_COLS * 2 + 3] = "";
+    memset(line, '-', width + 2);
+    line[0] = line[width + 1] = '+';
+    line[width + 2] = '\0';
+    put_text(screen, ANSI_TOP, ANSI_LEFT - 1, line);
+    put_text(screen, ANSI_TOP + height + 1, ANSI_LEFT - 1, line);
+    for (int i = 1; i <= height; i++) {
+      put_text(screen, ANSI_TOP + i, ANSI_LEFT - 1, "|");
+      put_text(screen, ANSI_TOP + i, ANSI_LEFT + width, "|");
+    }
+    put_text(screen, ANSI_TOP + 7, panel, "Next:");
+    memset(screen->cells, 0, sizeof(screen->cells));
+    mark_all_changed(&changes);
+    screen->valid = true;
+  }
+
+  if (screen->half) {
+    render_half_field(screen, info.field, changes.rows);
+  } else {
+    render_field(screen, info.field, changes.rows);
+  }
+
+  char text[32];
+  if (changes.fields & (Score_changed | High_score_changed)) {
+    sprintf(text, "Score: %-10d", info.score);
+    put_text(screen, ANSI_TOP + 1, panel, text);
+    sprintf(text, "Best:  %-10d", info.high_score);
+    put_text(screen, ANSI_TOP + 2, panel, text);
+  }
+  if (changes.fields & (Level_changed | Speed_changed)) {
+    sprintf(text, "Level: %-10d", info.level);
+    put_text(screen, ANSI_TOP + 4, panel, text);
+    float value = get_speed(info.speed);
+    if ((int)(value * 100) % 100 == 0) {
+      sprintf(text, "Speed: %dx    ", (int)value);
+    } else {
+      sprintf(text, "Speed: %.2fx", value);
+    }
+    put_text(screen, ANSI_TOP + 5, panel, text);
+  }
+  if (changes.next && screen->half) {
+    move_cursor(screen, ANSI_TOP + 8, panel);
+    for (int j = 0; j < NEXT_COLS; j++) {
+      put_half_cell(screen, info.next[0][j], info.next[1][j]);
+    }
+  } else if (changes.next) {
+    for (int i = 0; i < NEXT_ROWS; i++) {
+      move_cursor(screen, ANSI_TOP + 8 + i, panel);
+      for (int j = 0; j < NEXT_COLS; j++) {
+        set_color(screen, screen->fg, ansi_color(info.next[i][j]));
+        append_frame(screen, "  ");
+        screen->col += 2;
+      }
+    }
+  }
+  flush_frame(screen);
+}
+
+void draw_screen(void *context, Snapshot_t *snapshot, Changes_t changes,
+                 bool resized) {
+  Screen_t *screen = context;
+  if (resized || !screen->shown || snapshot->state != screen->state) {
+    reset_screen(screen);
+    screen->shown = true;
+    screen->state = snapshot->state;
+    if (snapshot->state != Play) render_message(screen, snapshot->state);
+  }
+  if (snapshot->state == Play) {
+    int *field[FIELD_ROWS], *next[NEXT_ROWS];
+    render_game(screen, snapshot_info(snapshot, field, next), changes);
+  }
+}
+
+void render_field(Screen_t *screen, int **field, uint32_t rows) {
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    if (!(rows & (1u << i))) continue;
+    int j = 0;
+    while (j < FIELD_COLS) {
+      int piece = field[i][j], start = j;
+      while (j < FIELD_COLS && field[i][j] == piece &&
+             field[i][j] != screen->cells[i][j]) {
+        screen->cells[i][j++] = piece;
+      }
+      if (j == start) {
+        j++;
+      } else {
+        move_cursor(screen, ANSI_TOP + 1 + i, ANSI_LEFT + start * 2);
+        set_color(screen, screen->fg, ansi_color(piece));
+        append_frame(screen, "%*s", (j - start) * 2, "");
+        screen->col += (j - start) * 2;
+      }
+    }
+  }
+}
+
+void render_half_field(Screen_t *screen, int **field, uint32_t rows) {
+  for (int i = 0; i < FIELD_ROWS; i += 2) {
+    if (!(rows & (3u << i))) continue;
+    for (int j = 0; j < FIELD_COLS; j++) {
+      int upper = field[i][j], lower = field[i + 1][j];
+      if (upper != screen->cells[i][j] || lower != screen->cells[i + 1][j]) {
+        move_cursor(screen, ANSI_TOP + 1 + i / 2, ANSI_LEFT + j);
+        put_half_cell(screen, upper, lower);
+        screen->cells[i][j] = upper;
+        screen->cells[i + 1][j] = lower;
+      }
+    }
+  }
+}
+
+void put_half_cell(Screen_t *screen, int upper, int lower) {
+  if (!upper && !lower) {
+    set_color(screen, screen->fg, -1);
+    append_frame(screen, " ");
+  } else if (!upper) {
+    set_color(screen, ansi_color(lower), -1);
+    append_frame(screen, "%s", LOWER_HALF);
+  } else {
+    set_color(screen, ansi_color(upper), ansi_color(lower));
+    append_frame(screen, "%s", UPPER_HALF);
+  }
+  screen->col++;
+}
+
+void render_message(Screen_t *screen, GameState_t state) {
+  const char *title = state == Begin  ? "T E T R I S"
+                      : state == Stop ? "P A U S E"
+                                      : "G A M E   O V E R";
+  const char *prompt = state == Begin  ? "Press S to play"
+                       : state == Stop ? "Press S to continue"
+                                       : "Press S to play again";
+  begin_frame(screen);
+  set_color(screen, -1, -1);
+  append_frame(screen, "\x1b[2J");
+  put_text(screen, ANSI_TOP + 4, ANSI_LEFT + 2, title);
+  put_text(screen, ANSI_TOP + 6, ANSI_LEFT, prompt);
+  screen->valid = false;
+  flush_frame(screen);
+}
+
+void reset_screen(Screen_t *screen) {
+  screen->valid = false;
+  screen->row = screen->col = 0;
+  screen->fg = screen->bg = -2;
+}
+
+void begin_frame(Screen_t *screen) {
+  screen->length = 0;
+  screen->start = get_time_ns();
+}
+
+void flush_frame(Screen_t *screen) {
+  if (screen->length == 0) return;
+  FrameStats_t *stats = &screen->stats;
+  size_t done = 0;
+  while (done < screen->length) {
+    ssize_t count =
+        write(STDOUT_FILENO, screen->buffer + done, screen->length - done);
+    stats->writes++;
+    if (count <= 0) break;
+    done += count;
+  }
+  int64_t time = get_time_ns() - screen->start;
+  stats->frames++;
+  stats->bytes += screen->length;
+  if ((long long)screen->length > stats->max_bytes)
+    stats->max_bytes = screen->length;
+  stats->time += time;
+  if (time > stats->max_time) stats->max_time = time;
+  screen->length = 0;
+}
+
+void append_frame(Screen_t *screen, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  size_t left = ANSI_BUFFER - screen->length;
+  int count = vsnprintf(screen->buffer + screen->length, left, format, args);
+  va_end(args);
+  if (count > 0 && (size_t)count < left) screen->length += count;
+}
+
+void move_cursor(Screen_t *screen, int row, int col) {
+  if (screen->row == row && screen->col == col) return;
+  char absolute[16], relative[16] = "";
+  sprintf(absolute, "\x1b[%d;%dH", row, col);
+  if (screen->row == row && screen->col > 0 && col > screen->col) {
+    if (col - screen->col == 1) {
+      sprintf(relative, "\x1b[C");
+    } else {
+      sprintf(relative, "\x1b[%dC", col - screen->col);
+    }
+  }
+  bool shorter = relative[0] && strlen(relative) < strlen(absolute);
+  append_frame(screen, "%s", shorter ? relative : absolute);
+  screen->row = row;
+  screen->col = col;
+}
+
+void set_color(Screen_t *screen, int fg, int bg) {
+  char sequence[48] = "\x1b[";
+  size_t length = strlen(sequence);
+  if (screen->fg != fg) length += append_color(screen, sequence + length, fg, 3);
+  if (screen->bg != bg) {
+    if (screen->fg != fg) sequence[length++] = ';';
+    length += append_color(screen, sequence + length, bg, 4);
+  }
+  if (screen->fg != fg || screen->bg != bg) {
+    append_frame(screen, "%sm", sequence);
+    screen->fg = fg;
+    screen->bg = bg;
+  }
+}
+
+int append_color(const Screen_t *screen, char *sequence, int color,
+                 int layer) {
+  static const int palette[8][3] = {
+      {0, 0, 0},     {205, 49, 49},  {13, 188, 121}, {229, 229, 16},
+      {36, 114, 200}, {188, 63, 188}, {17, 168, 205}, {229, 229, 229}};
+  int count;
+  if (color < 0) {
+    count = sprintf(sequence, "%d9", layer);
+  } else if (screen->truecolor) {
+    count = sprintf(sequence, "%d8;2;%d;%d;%d", layer, palette[color & 7][0],
+                    palette[color & 7][1], palette[color & 7][2]);
+  } else {
+    count = sprintf(sequence, "%d%d", layer, color & 7);
+  }
+  return count;
+}
+
+void put_text(Screen_t *screen, int row, int col, const char *text) {
+  move_cursor(screen, row, col);
+  set_color(screen, -1, -1);
+  append_frame(screen, "%s", text);
+  screen->col += strlen(text);
+}
+
+bool detect_truecolor(void) {
+  const char *colorterm = getenv("COLORTERM");
+  return colorterm &&
+         (!strcmp(colorterm, "truecolor") || !strcmp(colorterm, "24bit"));
+}
+
+int ansi_color(int piece) {
+  return piece ? curs_color(piece_color(piece)) : -1;
+}
+
+void print_stats(FILE *file, const FrameStats_t *stats) {
+  long long frames = stats->frames ? stats->frames : 1;
+  fprintf(file, "frames: %lld, writes: %lld, skipped: %lld\n", stats->frames,
+          stats->writes, stats->skipped);
+  fprintf(file, "bytes: %lld total, %lld per frame, %lld max\n", stats->bytes,
+          stats->bytes / frames, stats->max_bytes);
+  fprintf(file, "time: %lld us per frame, %lld us max\n",
+          (long long)(stats->time / frames / 1000),
+          (long long)(stats->max_time / 1000));
+}
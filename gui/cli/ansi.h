@@ -0,0 +1,286 @@
+/**
+ * @file ansi.h
+ * @brief Tetris raw ANSI renderer header file
+ */
+
+#ifndef TETRIS_ANSI_H
+#define TETRIS_ANSI_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "../../brick_game/tetris/backend.h"
+#include "frontend.h"
+#include "input.h"
+#include "render.h"
+
+#define ANSI_BUFFER 16384
+
+#define ANSI_TOP 2
+#define ANSI_LEFT 3
+
+#define UPPER_HALF "\xe2\x96\x80"
+#define LOWER_HALF "\xe2\x96\x84"
+
+/**
+ * @brief Structure representing the statistics of the rendered frames.
+ *
+ * The number of `write` calls equals the number of frames unless the terminal
+ * accepted a frame partially. Frames are skipped while the terminal has not
+ * drained the previous ones.
+ */
+typedef struct {
+  long long frames;    /**< The number of frames written. */
+  long long writes;    /**< The number of `write` calls. */
+  long long bytes;     /**< The total number of bytes written. */
+  long long max_bytes; /**< The size of the largest frame. */
+  int64_t time;        /**< The time spent on frames in nanoseconds. */
+  int64_t max_time;    /**< The longest frame in nanoseconds. */
+  long long skipped;   /**< The frames skipped while backed up. */
+} FrameStats_t;
+
+/**
+ * @brief Structure representing the terminal driven by the ANSI renderer.
+ *
+ * Each frame is composed into `buffer` as cursor movements, SGR color changes
+ * and text, and written to the terminal with a single `write` call. The
+ * renderer remembers the cursor position, the current colors and the cells
+ * shown, so a frame only contains what differs from the previous one.
+ *
+ * In the half-block mode each terminal cell shows two vertically adjacent
+ * field cells: the upper one as the foreground of `▀` and the lower one as
+ * its background, so the field takes one column and half a row per cell.
+ *
+ * The cursor position is 0 while unknown, and the colors are -1 for the
+ * default color and -2 while unknown. Colors are sent as 24-bit RGB values
+ * with `truecolor` and as the 8 basic ANSI colors otherwise. If the screen is
+ * not `valid`, the next frame repaints it completely.
+ */
+typedef struct {
+  char buffer[ANSI_BUFFER];          /**< The preallocated frame buffer. */
+  size_t length;                     /**< The number of bytes composed. */
+  int row;                           /**< The cursor row, 0 if unknown. */
+  int col;                           /**< The cursor column, 0 if unknown. */
+  int fg;                            /**< The current foreground color. */
+  int bg;                            /**< The current background color. */
+  bool half;                         /**< Whether half blocks are used. */
+  bool truecolor;                    /**< Whether colors are 24-bit RGB. */
+  int cells[FIELD_ROWS][FIELD_COLS]; /**< The field cells as shown. */
+  bool valid;                        /**< Whether the game screen is shown. */
+  bool shown;                        /**< Whether the terminal shows `state`. */
+  GameState_t state;                 /**< The game state shown. */
+  FrameStats_t stats;                /**< The frame statistics. */
+  bool show_stats;                   /**< Whether stats are printed on exit. */
+  int64_t start;                     /**< The start of the current frame. */
+  struct termios saved;              /**< The terminal attributes to restore. */
+} Screen_t;
+
+/**
+ * @brief Prepares the terminal for the ANSI renderer.
+ *
+ * This function switches the terminal to unbuffered input without echo,
+ * enters the alternate screen and hides the cursor. The 24-bit colors are
+ * used if the terminal advertises them.
+ *
+ * @param screen A pointer to the `Screen_t` structure to initialize.
+ * @param show_stats A boolean indicating whether the frame statistics are
+ * printed on exit.
+ * @param half A boolean indicating whether the field is drawn with half
+ * blocks.
+ * @return int 0 on success, -1 if the standard output is not a terminal.
+ *
+ * @see Screen_t
+ * @see detect_truecolor
+ */
+int init_screen(Screen_t *screen, bool show_stats, bool half);
+/**
+ * @brief Restores the terminal and prints the frame statistics if requested.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ *
+ * @see Screen_t
+ * @see print_stats
+ */
+void close_screen(Screen_t *screen);
+/**
+ * @brief Composes and writes a frame of the game screen.
+ *
+ * Only the field rows, panels and next piece area reported as changed are
+ * compared with the shown state, and each run of adjacent changed cells of
+ * the same color is written after a single cursor movement and color change.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param info The `GameInfo_t` structure containing the game state.
+ * @param changes The `Changes_t` structure with the changes since the last
+ * frame.
+ *
+ * @see Screen_t
+ * @see get_changes
+ */
+void render_game(Screen_t *screen, GameInfo_t info, Changes_t changes);
+/**
+ * @brief Draws a game snapshot with the ANSI renderer.
+ *
+ * This function is the `Draw_t` function of the ANSI frontend. On a state
+ * change or a terminal resize the screen is repainted, with the message of
+ * the static states; in the `Play` state the changed parts of the game are
+ * drawn with `render_game`.
+ *
+ * @param context A pointer to the `Screen_t` structure.
+ * @param snapshot A pointer to the `Snapshot_t` structure to draw.
+ * @param changes The changes since the last frame drawn.
+ * @param resized A boolean indicating whether the terminal has been resized.
+ *
+ * @see Draw_t
+ * @see render_game
+ * @see render_message
+ */
+void draw_screen(void *context, Snapshot_t *snapshot, Changes_t changes,
+                 bool resized);
+/**
+ * @brief Appends the changed field cells, two terminal columns per cell.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param field The game field.
+ * @param rows The mask of the changed field rows.
+ */
+void render_field(Screen_t *screen, int **field, uint32_t rows);
+/**
+ * @brief Appends the changed field cells in the half-block mode.
+ *
+ * A terminal row is compared with the shown state if either of its two field
+ * rows changed.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param field The game field.
+ * @param rows The mask of the changed field rows.
+ *
+ * @see put_half_cell
+ */
+void render_half_field(Screen_t *screen, int **field, uint32_t rows);
+/**
+ * @brief Appends a terminal cell showing two vertically adjacent cells.
+ *
+ * A cell with an empty upper half is drawn as `▄` on the default background,
+ * so the terminal background stays visible, and an empty cell as a space.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param upper The type of the upper piece, 0 for an empty cell.
+ * @param lower The type of the lower piece, 0 for an empty cell.
+ */
+void put_half_cell(Screen_t *screen, int upper, int lower);
+/**
+ * @brief Composes and writes the screen of a static state.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param state The state, one of `Begin`, `Stop` and `Game_over`.
+ *
+ * @see Screen_t
+ */
+void render_message(Screen_t *screen, GameState_t state);
+/**
+ * @brief Marks the terminal as no longer showing the game screen.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ */
+void reset_screen(Screen_t *screen);
+/**
+ * @brief Starts composing a frame.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ */
+void begin_frame(Screen_t *screen);
+/**
+ * @brief Writes the composed frame with a single `write` call and updates the
+ * statistics.
+ *
+ * Nothing is written if the frame is empty.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ *
+ * @see FrameStats_t
+ */
+void flush_frame(Screen_t *screen);
+/**
+ * @brief Appends formatted text to the frame.
+ *
+ * Text that does not fit into the buffer is dropped.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param format The `printf` format string.
+ */
+void append_frame(Screen_t *screen, const char *format, ...);
+/**
+ * @brief Appends the shortest cursor movement to a terminal position.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param row The terminal row, starting from 1.
+ * @param col The terminal column, starting from 1.
+ */
+void move_cursor(Screen_t *screen, int row, int col);
+/**
+ * @brief Appends a single color change for the colors that are not current.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param fg The ANSI color number of the foreground, or -1 for the default
+ * one.
+ * @param bg The ANSI color number of the background, or -1 for the default
+ * one.
+ */
+void set_color(Screen_t *screen, int fg, int bg);
+/**
+ * @brief Writes the SGR parameters selecting a color.
+ *
+ * In the truecolor mode the ANSI color number is mapped to an RGB value of
+ * the built-in palette.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param sequence The buffer to write the parameters to.
+ * @param color The ANSI color number, or -1 for the default color.
+ * @param layer 3 for the foreground, 4 for the background.
+ * @return int The number of characters written.
+ */
+int append_color(const Screen_t *screen, char *sequence, int color,
+                 int layer);
+/**
+ * @brief Appends text at a terminal position and tracks the cursor.
+ *
+ * @param screen A pointer to the `Screen_t` structure.
+ * @param row The terminal row, starting from 1.
+ * @param col The terminal column, starting from 1.
+ * @param text The text without control characters.
+ */
+void put_text(Screen_t *screen, int row, int col, const char *text);
+/**
+ * @brief Checks whether the terminal supports 24-bit colors.
+ *
+ * @return true if `COLORTERM` is `truecolor` or `24bit`, false otherwise.
+ */
+bool detect_truecolor(void);
+/**
+ * @brief Returns the ANSI color number of a piece type.
+ *
+ * @param piece The type of the piece, 0 for an empty cell.
+ * @return int The ANSI color number, or -1 for an empty cell.
+ *
+ * @see piece_color
+ * @see curs_color
+ */
+int ansi_color(int piece);
+/**
+ * @brief Prints the frame statistics.
+ *
+ * @param file The file to print the statistics to.
+ * @param stats A pointer to the `FrameStats_t` structure.
+ */
+void print_stats(FILE *file, const FrameStats_t *stats);
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file events.c
+ * @brief Source file for tetris frontend event loop
+ */
+
+#include "events.h"
+
+static int resize_fd = -1;
+
+int init_events(Events_t *events) {
+  events->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+  events->resize_fd = eventfd(0, EFD_NONBLOCK);
+  events->origin = get_time_ns();
+  events->ticks = 0;
+  events->resized = false;
+  events->skipped = 0;
+  events->key = -1;
+  resize_fd = events->resize_fd;
+  struct sigaction action = {0};
+  action.sa_handler = handle_resize;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGWINCH, &action, NULL);
+  int res = start_input(&events->input);
+  return events->timer_fd < 0 || events->resize_fd < 0 ? -1 : res;
+}
+
+void close_events(Events_t *events) {
+  stop_input(&events->input);
+  signal(SIGWINCH, SIG_DFL);
+  resize_fd = -1;
+  if (events->timer_fd >= 0) close(events->timer_fd);
+  if (events->resize_fd >= 0) close(events->resize_fd);
+  events->timer_fd = events->resize_fd = -1;
+}
+
+bool next_event(Events_t *events, ExpandedGameInfo_t *info,
+                UserAction_t *action) {
+  bool tick = false, ready = false;
+  events->skipped = 0;
+  events->key = -1;
+  while (!ready) {
+    bool play = info->state == Play;
+    int64_t now = get_time_ns();
+    if (!play) {
+      events->origin = now;
+      events->ticks = 0;
+    }
+    int64_t due = (now - events->origin) / TICK_NS - events->ticks;
+    if (due > 1) {
+      int skipped = skip_ticks(info, due - 1);
+      events->ticks += skipped;
+      events->skipped += skipped;
+      due = (now - events->origin) / TICK_NS - events->ticks;
+    }
+    if (due > CATCH_UP_TICKS) {
+      events->ticks += due - CATCH_UP_TICKS;
+      due = CATCH_UP_TICKS;
+    }
+    int64_t deadline = events->origin + (events->ticks + 1) * TICK_NS;
+    InputEvent_t event;
+    bool input = peek_input(&events->input.queue, &event);
+    if (events->resized) {
+      *action = -1;
+      ready = true;
+    } else if (input && (!play || due <= 0 || event.time < deadline)) {
+      pop_input(&events->input.queue);
+      *action = user_action(event.key);
+      events->key = event.key;
+      ready = true;
+    } else if (play && due > 0) {
+      *action = -1;
+      events->ticks++;
+      tick = ready = true;
+    } else if (play) {
+      int64_t next = events->ticks + 1 + get_idle_ticks(info);
+      wait_events(events, events->origin + next * TICK_NS);
+    } else {
+      wait_events(events, -1);
+    }
+  }
+  return tick;
+}
+
+void wait_events(Events_t *events, int64_t deadline) {
+  struct pollfd fds[3] = {{events->input.notify_fd, POLLIN, 0},
+                          {events->resize_fd, POLLIN, 0},
+                          {events->timer_fd, POLLIN, 0}};
+  int count = 2, timeout = -1;
+  if (deadline >= 0 && events->timer_fd >= 0) {
+    struct itimerspec spec = {{0, 0}, {0, 0}};
+    spec.it_value.tv_sec = deadline / NS_PER_SEC;
+    spec.it_value.tv_nsec = deadline % NS_PER_SEC;
+    timerfd_settime(events->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+    count = 3;
+  } else if (deadline >= 0) {
+    int64_t left = deadline - get_time_ns();
+    timeout = left > 0 ? (left + 999999) / 1000000 : 0;
+  }
+  poll(fds, count, timeout);
+  uint64_t value;
+  if (fds[0].revents && read(events->input.notify_fd, &value, sizeof(value)))
+    value = 0;
+  if (fds[1].revents && read(events->resize_fd, &value, sizeof(value)) > 0)
+    events->resized = true;
+  if (count == 3 && read(events->timer_fd, &value, sizeof(value)) < 0)
+    value = 0;
+}
+
+void handle_resize(int signal) {
+  (void)signal;
+  uint64_t one = 1;
+  if (resize_fd >= 0 && write(resize_fd, &one, sizeof(one)) < 0) one = 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file events.h
+ * @brief Tetris frontend event loop header file
+ */
+
+#ifndef TETRIS_EVENTS_H
+#define TETRIS_EVENTS_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/timerfd.h>
+
+#include "../../brick_game/tetris/backend.h"
+#include "input.h"
+
+#define TICK_NS (DELAY * 1000000LL)
+#define CATCH_UP_TICKS 25
+
+/**
+ * @brief Structure representing the event sources of the frontend.
+ *
+ * Game iterations are counted on the monotonic clock from `origin`: the
+ * iteration number `n` is due exactly `n * TICK_NS` nanoseconds after it, so
+ * late wake-ups, rendering and slow terminals do not accumulate into drift.
+ * Iterations are driven by the clock alone; user input is applied between
+ * them. The caller resets `resized` once the screen is repainted.
+ */
+typedef struct {
+  Input_t input;  /**< The input thread and its queue of keys. */
+  int timer_fd;   /**< The timer armed for the next iteration. */
+  int resize_fd;  /**< The descriptor signalled on resize. */
+  int64_t origin; /**< The start of the count in nanoseconds. */
+  int64_t ticks;  /**< The iterations processed since `origin`. */
+  bool resized;   /**< Whether the terminal has been resized. */
+  int skipped;    /**< The idle iterations of the last event. */
+  int key;        /**< The key of the last event, or -1. */
+} Events_t;
+
+/**
+ * @brief Initializes the event sources and starts the input thread.
+ *
+ * The function also installs the `SIGWINCH` handler, which signals
+ * `resize_fd`.
+ *
+ * @param events A pointer to the `Events_t` structure to initialize.
+ * @return int 0 on success, -1 if the timer or the input thread could not be
+ * created.
+ *
+ * @see Events_t
+ * @see start_input
+ */
+int init_events(Events_t *events);
+/**
+ * @brief Stops the input thread and releases the event sources.
+ *
+ * @param events A pointer to the `Events_t` structure to release.
+ *
+ * @see Events_t
+ * @see stop_input
+ */
+void close_events(Events_t *events);
+/**
+ * @brief Waits for the next user action or game iteration.
+ *
+ * This function returns the keys queued by the input thread in the order they
+ * were read, and a game iteration once it is due. A key read before the due
+ * iteration is returned first, so the queue is drained on every iteration.
+ * When nothing is ready, the function blocks in `poll` on the input thread
+ * and, in the `Play` state, on a timer armed for the next iteration that can
+ * move the piece. Idle iterations in between are accounted for with
+ * `skip_ticks` instead of being run one by one. Iterations missed by a late
+ * wake-up are caught up back to back, at most `CATCH_UP_TICKS` of them; a
+ * longer stall (for example a suspended process) is not replayed.
+ *
+ * @param events A pointer to the `Events_t` structure of the event sources.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param action A pointer the action to process is written to, -1 for a game
+ * iteration.
+ * @return bool `true` for a game iteration, `false` for a user action. On a
+ * terminal resize the function sets `resized` and returns `false` with the
+ * action -1.
+ *
+ * @see Events_t
+ * @see get_idle_ticks
+ * @see skip_ticks
+ * @see wait_events
+ */
+bool next_event(Events_t *events, ExpandedGameInfo_t *info,
+                UserAction_t *action);
+/**
+ * @brief Blocks until a key is queued, the terminal is resized or the
+ * deadline passes.
+ *
+ * @param events A pointer to the `Events_t` structure of the event sources.
+ * @param deadline The monotonic time in nanoseconds to wake up at, or a
+ * negative value to wait for input only.
+ *
+ * @see Events_t
+ */
+void wait_events(Events_t *events, int64_t deadline);
+/**
+ * @brief Handles the `SIGWINCH` signal by signalling the resize descriptor.
+ *
+ * @param signal The signal number.
+ */
+void handle_resize(int signal);
+
+#endif
@@ -8,6 +8,7 @@
 void init_ncurses() {
   initscr();
   noecho();
+  cbreak();
   timeout(0);
   curs_set(0);
   keypad(stdscr, TRUE);
@@ -45,17 +46,25 @@ void clear_wins(WINDOW *info, WINDOW *field, WINDOW *score, WINDOW *level,
   wrefresh(next);
 }
 
-void print_field(WINDOW *win, int **field) {
-  werase(win);
-  box(win, 0, 0);
+void print_field(WINDOW *win, int **field, uint32_t rows, Frame_t *frame) {
+  if (!frame->valid) {
+    werase(win);
+    box(win, 0, 0);
+  }
 
   for (int i = 0; i < FIELD_ROWS; i++) {
-    for (int j = 0; j < FIELD_COLS; j++) {
-      if (field[i][j]) {
-        int pair_number = piece_color(field[i][j]);
-        wattron(win, COLOR_PAIR(pair_number));
-        mvwprintw(win, i + 1, j * 2 + 1, "  ");
-        wattroff(win, COLOR_PAIR(pair_number));
+    if (frame->valid && !(rows & (1u << i))) continue;
+    int j = 0;
+    while (j < FIELD_COLS) {
+      int color = field[i][j], start = j;
+      while (j < FIELD_COLS && field[i][j] == color &&
+             (!frame->valid || field[i][j] != frame->field[i][j])) {
+        frame->field[i][j++] = color;
+      }
+      if (j == start) {
+        j++;
+      } else if (frame->valid || color) {
+        print_cells(win, i + 1, start * 2 + 1, color, j - start);
       }
     }
   }
@@ -63,6 +72,13 @@ void print_field(WINDOW *win, int **field) {
   wnoutrefresh(win);
 }
 
+void print_cells(WINDOW *win, int row, int col, int color, int count) {
+  int pair_number = color ? piece_color(color) : BLACK;
+  wattron(win, COLOR_PAIR(pair_number));
+  mvwprintw(win, row, col, "%*s", count * 2, "");
+  wattroff(win, COLOR_PAIR(pair_number));
+}
+
 void print_level(WINDOW *win, int level, int speed) {
   werase(win);
   box(win, 0, 0);
@@ -117,14 +133,43 @@ void print_next(WINDOW *win, int **next) {
 }
 
 void print_game(WINDOW *field, WINDOW *score, WINDOW *level, WINDOW *next,
-                GameInfo_t info) {
-  print_field(field, info.field);
-  print_score(score, info.score, info.high_score);
-  print_level(level, info.level, info.speed);
-  print_next(next, info.next);
+                GameInfo_t info, Changes_t changes, Frame_t *frame) {
+  print_field(field, info.field, changes.rows, frame);
+  if (!frame->valid || changes.fields & (Score_changed | High_score_changed))
+    print_score(score, info.score, info.high_score);
+  if (!frame->valid || changes.fields & (Level_changed | Speed_changed))
+    print_level(level, info.level, info.speed);
+  if (!frame->valid || changes.next) print_next(next, info.next);
+  frame->valid = true;
   doupdate();
 }
 
+void reset_frame(Frame_t *frame) { frame->valid = false; }
+
+void draw_windows(void *context, Snapshot_t *snapshot, Changes_t changes,
+                  bool resized) {
+  Display_t *display = context;
+  if (resized) {
+    endwin();
+    refresh();
+  }
+  if (resized || !display->shown || snapshot->state != display->state) {
+    clear_wins(display->aux, display->field, display->score, display->level,
+               display->next);
+    reset_frame(&display->frame);
+    display->shown = true;
+    display->state = snapshot->state;
+    if (snapshot->state == Begin) print_start(display->aux);
+    if (snapshot->state == Stop) print_pause(display->aux);
+    if (snapshot->state == Game_over) print_game_over(display->aux);
+  }
+  if (snapshot->state == Play) {
+    int *field[FIELD_ROWS], *next[NEXT_ROWS];
+    print_game(display->field, display->score, display->level, display->next,
+               snapshot_info(snapshot, field, next), changes, &display->frame);
+  }
+}
+
 void print_title(WINDOW *win, int height, int coord, const char *text[],
                  int color) {
   wattron(win, COLOR_PAIR(color));
@@ -11,6 +11,7 @@
 
 #include "../../brick_game/tetris/defines.h"
 #include "../../brick_game/tetris/objects.h"
+#include "../../brick_game/tetris/snapshot.h"
 
 #define WIN_HEIGHT 22
 #define WIN_WIDTH 22
@@ -45,13 +46,39 @@
 #define J 6
 #define T 7
 
+/**
+ * @brief Structure representing the last frame printed in the game windows.
+ *
+ * The game field is compared with the frame in the rows the engine reports as
+ * changed, and only the differing cells are repainted. If the frame is not
+ * `valid`, everything is repainted.
+ */
+typedef struct {
+  int field[FIELD_ROWS][FIELD_COLS]; /**< The game field as printed. */
+  bool valid;                        /**< Whether the windows show the frame. */
+} Frame_t;
+
+/**
+ * @brief Structure representing the game windows drawn by the render thread.
+ */
+typedef struct {
+  WINDOW *aux;       /**< The start, pause and game over screens. */
+  WINDOW *field;     /**< The window for the game field. */
+  WINDOW *score;     /**< The window for the score. */
+  WINDOW *level;     /**< The window for the level. */
+  WINDOW *next;      /**< The window for the next piece. */
+  Frame_t frame;     /**< The last printed frame. */
+  bool shown;        /**< Whether the windows show `state`. */
+  GameState_t state; /**< The game state the windows show. */
+} Display_t;
+
 /**
  * @brief Initializes the ncurses library.
  *
  * This function initializes the ncurses library, which is used for creating
  * text-based user interface in the terminal. It sets up the terminal for
- * non-blocking input, disables echoing of input characters, hides the cursor,
- * and enables the use of special keys (like arrow keys) for input.
+ * unbuffered non-blocking input, disables echoing of input characters, hides
+ * the cursor, and enables the use of special keys (like arrow keys) for input.
  */
 void init_ncurses();
 /**
@@ -155,36 +182,88 @@ void print_game_over(WINDOW *win);
  * This function prints the current game state in the specified windows,
  * including the game field, the score, the level, and the next piece. It uses
  * the `print_field`, `print_score`, `print_level`, and `print_next` functions
- * to print the respective parts of the game state.
- *
- * @param field Pointer to the window where the game field will be printed.
- * @param score Pointer to the window where the score will be printed.
- * @param level Pointer to the window where the level will be printed.
- * @param next  Pointer to the window where the next piece will be printed.
- * @param info  The `GameInfo_t` structure containing the game state.
- *
+ * to print the respective parts of the game state. Only the parts reported
+ * as changed by the engine are repainted, unless the frame is no longer shown.
+ *
+ * @param field   Pointer to the window where the game field will be printed.
+ * @param score   Pointer to the window where the score will be printed.
+ * @param level   Pointer to the window where the level will be printed.
+ * @param next    Pointer to the window where the next piece will be printed.
+ * @param info    The `GameInfo_t` structure containing the game state.
+ * @param changes The `Changes_t` structure with the changes since the last
+ * frame.
+ * @param frame   Pointer to the last printed frame, updated by the function.
+ *
+ * @see Frame_t
+ * @see get_changes
  * @see print_field
  * @see print_score
  * @see print_level
  * @see print_next
  */
 void print_game(WINDOW *playground, WINDOW *score, WINDOW *level, WINDOW *next,
-                GameInfo_t info);
+                GameInfo_t info, Changes_t changes, Frame_t *frame);
+/**
+ * @brief Marks the last printed frame as no longer shown.
+ *
+ * This function should be called whenever the game windows are cleared, so
+ * that the next `print_game` call repaints them completely.
+ *
+ * @param frame Pointer to the last printed frame.
+ *
+ * @see Frame_t
+ */
+void reset_frame(Frame_t *frame);
+/**
+ * @brief Draws a game snapshot in the game windows.
+ *
+ * This function is the `Draw_t` function of the ncurses frontend. On a state
+ * change or a terminal resize the windows are cleared and the start, pause or
+ * game over screen is printed once; in the `Play` state the changed parts of
+ * the game are printed with `print_game`.
+ *
+ * @param context Pointer to the `Display_t` structure.
+ * @param snapshot Pointer to the `Snapshot_t` structure to draw.
+ * @param changes The changes since the last frame drawn.
+ * @param resized A boolean indicating whether the terminal has been resized.
+ *
+ * @see Display_t
+ * @see Draw_t
+ * @see print_game
+ */
+void draw_windows(void *context, Snapshot_t *snapshot, Changes_t changes,
+                  bool resized);
 
 /**
  * @brief Prints the game field in the specified window.
  *
  * This function prints the game field in the specified window, using different
- * colors for each type of piece. It iterates through the game field and prints
- * each piece at the appropriate position in the window. The function uses the
- * `piece_color` function to determine the color of each piece.
+ * colors for each type of piece. Only the cells of the changed rows that
+ * differ from the frame are printed, and each run of adjacent changed cells of
+ * the same color is printed with a single attribute change using the
+ * `print_cells` function.
  *
  * @param win   Pointer to the window where the game field will be printed.
  * @param field The matrix representing the game field.
+ * @param rows  The mask of the changed rows, bit `i` for row `i`.
+ * @param frame Pointer to the last printed frame.
+ *
+ * @see Frame_t
+ * @see print_cells
+ */
+void print_field(WINDOW *win, int **field, uint32_t rows, Frame_t *frame);
+/**
+ * @brief Prints a horizontal run of cells of the same color.
+ *
+ * @param win   Pointer to the window where the cells will be printed.
+ * @param row   The window row of the run.
+ * @param col   The window column of the first cell.
+ * @param color The piece type of the cells, 0 for empty cells.
+ * @param count The number of cells in the run.
  *
  * @see piece_color
  */
-void print_field(WINDOW *win, int **);
+void print_cells(WINDOW *win, int row, int col, int color, int count);
 /**
  * @brief Prints the current score and high score in the specified window.
  *
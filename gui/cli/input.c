@@ -0,0 +1,119 @@
+/**
+ * @file input.c
+ * @brief Source file for tetris frontend input thread
+ */
+
+#include "input.h"
+
+int start_input(Input_t *input) {
+  atomic_init(&input->queue.head, 0);
+  atomic_init(&input->queue.tail, 0);
+  input->escape = 0;
+  input->notify_fd = eventfd(0, EFD_NONBLOCK);
+  input->stop_fd = eventfd(0, EFD_NONBLOCK);
+  int res = input->notify_fd < 0 || input->stop_fd < 0 ? -1 : 0;
+  if (res == 0 && pthread_create(&input->thread, NULL, read_input, input))
+    res = -1;
+  if (res) {
+    if (input->notify_fd >= 0) close(input->notify_fd);
+    if (input->stop_fd >= 0) close(input->stop_fd);
+    input->notify_fd = input->stop_fd = -1;
+  }
+  return res;
+}
+
+void stop_input(Input_t *input) {
+  if (input->stop_fd >= 0) {
+    uint64_t one = 1;
+    if (write(input->stop_fd, &one, sizeof(one)) == sizeof(one))
+      pthread_join(input->thread, NULL);
+    close(input->stop_fd);
+    close(input->notify_fd);
+    input->notify_fd = input->stop_fd = -1;
+  }
+}
+
+void *read_input(void *arg) {
+  Input_t *input = arg;
+  bool running = true;
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGWINCH);
+  pthread_sigmask(SIG_BLOCK, &signals, NULL);
+  while (running) {
+    struct pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0},
+                            {input->stop_fd, POLLIN, 0}};
+    int ready = poll(fds, 2, input->escape ? ESCAPE_TIMEOUT : -1);
+    if (fds[1].revents) running = false;
+    if (ready == 0) input->escape = 0;
+    unsigned char buffer[64];
+    ssize_t count = 0;
+    if (running && fds[0].revents) {
+      count = read(STDIN_FILENO, buffer, sizeof(buffer));
+      if (count <= 0) running = false;
+    }
+    int64_t time = get_time_ns();
+    bool pushed = false;
+    for (ssize_t i = 0; i < count; i++) {
+      int key = decode_key(input, buffer[i]);
+      if (key != ERR)
+        pushed |= push_input(&input->queue, (InputEvent_t){key, time});
+    }
+    if (pushed) {
+      uint64_t one = 1;
+      if (write(input->notify_fd, &one, sizeof(one)) < 0) running = false;
+    }
+  }
+  return NULL;
+}
+
+int decode_key(Input_t *input, unsigned char byte) {
+  int key = ERR;
+  if (input->escape == 1) {
+    input->escape = byte == '[' || byte == 'O' ? 2 : 0;
+  } else if (input->escape == 2) {
+    if (byte >= 0x40 && byte <= 0x7e) {
+      input->escape = 0;
+      key = byte == 'A'   ? KEY_UP
+            : byte == 'B' ? KEY_DOWN
+            : byte == 'C' ? KEY_RIGHT
+            : byte == 'D' ? KEY_LEFT
+                          : ERR;
+    }
+  } else if (byte == 27) {
+    input->escape = 1;
+  } else {
+    key = byte;
+  }
+  return key;
+}
+
+bool push_input(InputQueue_t *queue, InputEvent_t event) {
+  size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+  size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+  bool res = tail - head < INPUT_QUEUE;
+  if (res) {
+    queue->events[tail & (INPUT_QUEUE - 1)] = event;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+  }
+  return res;
+}
+
+bool peek_input(InputQueue_t *queue, InputEvent_t *event) {
+  size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+  size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+  bool res = head != tail;
+  if (res) *event = queue->events[head & (INPUT_QUEUE - 1)];
+  return res;
+}
+
+void pop_input(InputQueue_t *queue) {
+  size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+  atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+}
+
+int64_t get_time_ns() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * NS_PER_SEC + now.tv_nsec;
+}
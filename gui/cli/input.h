@@ -0,0 +1,149 @@
+/**
+ * @file input.h
+ * @brief Tetris frontend input thread header file
+ */
+
+#ifndef TETRIS_INPUT_H
+#define TETRIS_INPUT_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <ncurses.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#define INPUT_QUEUE 256
+#define ESCAPE_TIMEOUT 25
+#define NS_PER_SEC 1000000000LL
+
+/**
+ * @brief Structure representing a key read by the input thread.
+ */
+typedef struct {
+  int key;      /**< The key code, arrows as ncurses codes. */
+  int64_t time; /**< The monotonic time the key was read at. */
+} InputEvent_t;
+
+/**
+ * @brief Structure representing the single-producer single-consumer queue of
+ * input events.
+ *
+ * The input thread is the only writer of `tail` and the frontend loop is the
+ * only writer of `head`, so the queue needs no locks. The size is a power of
+ * two and the indices wrap around it.
+ */
+typedef struct {
+  InputEvent_t events[INPUT_QUEUE]; /**< The ring buffer of events. */
+  _Atomic size_t head;              /**< The index of the oldest event. */
+  _Atomic size_t tail;              /**< The index after the newest event. */
+} InputQueue_t;
+
+/**
+ * @brief Structure representing the input thread.
+ *
+ * The escape sequence decoder is in state 0 outside of a sequence, 1 after the
+ * escape character and 2 inside a control sequence.
+ */
+typedef struct {
+  InputQueue_t queue; /**< The queue the keys are pushed to. */
+  pthread_t thread;   /**< The thread reading the standard input. */
+  int notify_fd;      /**< The descriptor signalled on a key. */
+  int stop_fd;        /**< The descriptor signalled to stop. */
+  int escape;         /**< The escape sequence decoder state. */
+} Input_t;
+
+/**
+ * @brief Starts the input thread.
+ *
+ * @param input A pointer to the `Input_t` structure to initialize.
+ * @return int 0 on success, -1 if the thread could not be started.
+ *
+ * @see Input_t
+ * @see read_input
+ */
+int start_input(Input_t *input);
+/**
+ * @brief Stops the input thread and releases its descriptors.
+ *
+ * @param input A pointer to the `Input_t` structure of the running thread.
+ *
+ * @see Input_t
+ */
+void stop_input(Input_t *input);
+/**
+ * @brief The body of the input thread.
+ *
+ * This function blocks `SIGWINCH`, so that it is handled by the frontend
+ * loop, then waits for the standard input, reads the available bytes at
+ * once, decodes them into keys, stamps them with the monotonic clock and
+ * pushes them to the queue. It returns when `stop_fd` is signalled or the
+ * standard input is closed.
+ *
+ * @param arg A pointer to the `Input_t` structure of the thread.
+ * @return void* Always `NULL`.
+ *
+ * @see decode_key
+ * @see push_input
+ */
+void *read_input(void *arg);
+/**
+ * @brief Decodes one byte of the input.
+ *
+ * Arrow key escape sequences are translated to the ncurses key codes, other
+ * escape sequences are dropped.
+ *
+ * @param input A pointer to the `Input_t` structure holding the decoder state.
+ * @param byte The byte read from the standard input.
+ * @return int The key code, or `ERR` if the byte does not complete a key.
+ *
+ * @see Input_t
+ */
+int decode_key(Input_t *input, unsigned char byte);
+/**
+ * @brief Pushes an event to the queue.
+ *
+ * @param queue A pointer to the `InputQueue_t` structure.
+ * @param event The event to push.
+ * @return bool `true` if the event has been pushed, `false` if the queue is
+ * full.
+ *
+ * @see InputQueue_t
+ */
+bool push_input(InputQueue_t *queue, InputEvent_t event);
+/**
+ * @brief Reads the oldest event of the queue without removing it.
+ *
+ * @param queue A pointer to the `InputQueue_t` structure.
+ * @param event A pointer to the `InputEvent_t` structure the event is written
+ * to.
+ * @return bool `true` if there is an event, `false` if the queue is empty.
+ *
+ * @see InputQueue_t
+ * @see pop_input
+ */
+bool peek_input(InputQueue_t *queue, InputEvent_t *event);
+/**
+ * @brief Removes the oldest event of the queue.
+ *
+ * @param queue A pointer to the `InputQueue_t` structure.
+ *
+ * @see InputQueue_t
+ * @see peek_input
+ */
+void pop_input(InputQueue_t *queue);
+/**
+ * @brief Returns the current time of the monotonic clock.
+ *
+ * @return int64_t The time in nanoseconds.
+ */
+int64_t get_time_ns();
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file render.c
+ * @brief Source file for tetris frontend render thread
+ */
+
+#include "render.h"
+
+int start_renderer(Renderer_t *renderer, Draw_t draw, void *context) {
+  init_snapshots(&renderer->snapshots);
+  atomic_init(&renderer->stop, false);
+  atomic_init(&renderer->resized, false);
+  renderer->draw = draw;
+  renderer->context = context;
+  renderer->skipped = 0;
+  renderer->notify_fd = eventfd(0, EFD_NONBLOCK);
+  int res = renderer->notify_fd < 0 ? -1 : 0;
+  if (res == 0 &&
+      pthread_create(&renderer->thread, NULL, run_renderer, renderer)) {
+    close(renderer->notify_fd);
+    renderer->notify_fd = -1;
+    res = -1;
+  }
+  return res;
+}
+
+void stop_renderer(Renderer_t *renderer) {
+  if (renderer->notify_fd >= 0) {
+    uint64_t one = 1;
+    atomic_store(&renderer->stop, true);
+    if (write(renderer->notify_fd, &one, sizeof(one)) == sizeof(one))
+      pthread_join(renderer->thread, NULL);
+    close(renderer->notify_fd);
+    renderer->notify_fd = -1;
+  }
+}
+
+void publish_frame(Renderer_t *renderer, ExpandedGameInfo_t *info,
+                   bool resized) {
+  if (resized) atomic_store(&renderer->resized, true);
+  publish_snapshot(&renderer->snapshots, info);
+  uint64_t one = 1;
+  if (write(renderer->notify_fd, &one, sizeof(one)) < 0) one = 0;
+}
+
+void *run_renderer(void *arg) {
+  Renderer_t *renderer = arg;
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGWINCH);
+  pthread_sigmask(SIG_BLOCK, &signals, NULL);
+  Snapshot_t *snapshot = NULL;
+  Changes_t changes = {0, 0, false};
+  GameState_t state = Begin;
+  bool drawn = false, resized = false, deferred = false;
+  while (!atomic_load(&renderer->stop)) {
+    struct pollfd fd = {renderer->notify_fd, POLLIN, 0};
+    uint64_t value;
+    if (poll(&fd, 1, deferred ? RETRY_MS : -1) > 0 &&
+        read(renderer->notify_fd, &value, sizeof(value)) < 0)
+      value = 0;
+    Snapshot_t *newest = acquire_snapshot(&renderer->snapshots);
+    if (newest) {
+      snapshot = newest;
+      merge_changes(&changes, newest->changes);
+    }
+    resized |= atomic_exchange(&renderer->resized, false);
+    deferred = false;
+    if (!snapshot || atomic_load(&renderer->stop)) continue;
+    if (drawn && !resized && snapshot->state == state && is_unchanged(changes))
+      continue;
+    if (!output_ready()) {
+      renderer->skipped++;
+      deferred = true;
+      continue;
+    }
+    int64_t start = get_time_ns();
+    renderer->draw(renderer->context, snapshot, changes, resized);
+    changes = (Changes_t){0, 0, false};
+    state = snapshot->state;
+    drawn = true;
+    resized = false;
+    int64_t left = FRAME_NS - (get_time_ns() - start);
+    if (left > 0) {
+      struct timespec pause = {0, left};
+      nanosleep(&pause, NULL);
+    }
+  }
+  return NULL;
+}
+
+bool output_ready(void) {
+  struct pollfd fd = {STDOUT_FILENO, POLLOUT, 0};
+  int queued = 0;
+  bool ready = poll(&fd, 1, 0) != 0;
+  if (ready && ioctl(STDOUT_FILENO, TIOCOUTQ, &queued) == 0 &&
+      queued > OUTPUT_BACKLOG)
+    ready = false;
+  return ready;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file render.h
+ * @brief Tetris frontend render thread header file
+ */
+
+#ifndef TETRIS_RENDER_H
+#define TETRIS_RENDER_H
+
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../brick_game/tetris/snapshot.h"
+#include "input.h"
+
+#define FRAME_NS (NS_PER_SEC / 60)
+#define OUTPUT_BACKLOG 2048
+#define RETRY_MS 2
+
+/**
+ * @brief Type of the function drawing a frame.
+ *
+ * @param context The frontend state passed to `start_renderer`.
+ * @param snapshot A pointer to the `Snapshot_t` structure to draw.
+ * @param changes The changes since the last frame drawn.
+ * @param resized A boolean indicating whether the terminal has been resized
+ * since the last frame drawn.
+ */
+typedef void (*Draw_t)(void *context, Snapshot_t *snapshot, Changes_t changes,
+                       bool resized);
+
+/**
+ * @brief Structure representing the render thread.
+ *
+ * The game loop publishes snapshots of the game state to `snapshots` and the
+ * render thread draws the newest of them, at most once per `FRAME_NS`, so a
+ * slow terminal delays neither the game iterations nor the input handling.
+ * While the terminal has not drained the previous frames, the thread skips
+ * frames and merges their changes, so the frame finally sent shows the newest
+ * state.
+ */
+typedef struct {
+  SnapshotBuffer_t snapshots; /**< The triple buffer of game snapshots. */
+  pthread_t thread;           /**< The render thread. */
+  int notify_fd;              /**< The descriptor signalled on publish. */
+  atomic_bool stop;           /**< Whether the thread has to finish. */
+  atomic_bool resized;        /**< Whether the terminal has been resized. */
+  Draw_t draw;                /**< The function drawing a frame. */
+  void *context;              /**< The frontend state passed to `draw`. */
+  long long skipped;          /**< The frames skipped while backed up. */
+} Renderer_t;
+
+/**
+ * @brief Starts the render thread.
+ *
+ * @param renderer A pointer to the `Renderer_t` structure to initialize.
+ * @param draw The function drawing a frame.
+ * @param context The frontend state passed to `draw`, used by the render
+ * thread only until `stop_renderer` returns.
+ * @return int 0 on success, -1 if the thread could not be started.
+ *
+ * @see Renderer_t
+ */
+int start_renderer(Renderer_t *renderer, Draw_t draw, void *context);
+/**
+ * @brief Stops the render thread and waits for it to finish.
+ *
+ * @param renderer A pointer to the `Renderer_t` structure.
+ *
+ * @see Renderer_t
+ */
+void stop_renderer(Renderer_t *renderer);
+/**
+ * @brief Publishes the game state to the render thread.
+ *
+ * The function copies the state and resets its changes, and never waits for
+ * the render thread.
+ *
+ * @param renderer A pointer to the `Renderer_t` structure.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param resized A boolean indicating whether the terminal has been resized.
+ *
+ * @see publish_snapshot
+ */
+void publish_frame(Renderer_t *renderer, ExpandedGameInfo_t *info,
+                   bool resized);
+/**
+ * @brief Runs the render thread.
+ *
+ * The thread waits for a published snapshot, takes over the newest one and
+ * draws it if it differs from the last frame drawn, then sleeps for the rest
+ * of the frame period.
+ *
+ * @param arg A pointer to the `Renderer_t` structure.
+ * @return void* `NULL`.
+ *
+ * @see acquire_snapshot
+ * @see output_ready
+ */
+void *run_renderer(void *arg);
+/**
+ * @brief Checks whether the terminal has drained the previous frames.
+ *
+ * The terminal is congested if the standard output is not writable without
+ * blocking or more than `OUTPUT_BACKLOG` bytes are still queued in the kernel
+ * (`TIOCOUTQ`).
+ *
+ * @return bool `true` if a frame can be sent, `false` if it has to be
+ * skipped.
+ */
+bool output_ready(void);
+
+#endif
@@ -0,0 +1,200 @@
+#include "../brick_game/tetris/archive.h"
+#include "../brick_game/tetris/bot.h"
+#include "../brick_game/tetris/finesse.h"
+#include "tetris_test.h"
+
+#define TEST_ARCHIVE_PATH "test_archive.bin"
+#define TEST_ARCHIVE_REPLAY "test_archive.rpl"
+
+static void record_bot_game(uint64_t seed, int pieces) {
+  ExpandedGameInfo_t live;
+  Recorder_t recorder;
+  create_seeded_game(&live, seed);
+  ck_assert(open_recorder(&recorder, TEST_ARCHIVE_REPLAY, seed));
+  record_action(&recorder, Start);
+  process_action(&live, Start);
+  for (int i = 0; i < pieces && live.state != Game_over; i++) {
+    Piece_t target;
+    Path_t path = {.length = 0};
+    if (choose_placement(&live, NULL, NULL, &target))
+      find_path(&live, target, &path);
+    for (int k = 0; k < path.length; k++) {
+      record_ticks(&recorder, 3);
+      advance_ticks(&live, 3);
+      record_action(&recorder, path.keys[k]);
+      process_action(&live, path.keys[k]);
+    }
+    record_action(&recorder, Up);
+    process_action(&live, Up);
+    record_ticks(&recorder, skip_ticks(&live, 1000) + 1);
+    process_input(&live, -1, false);
+  }
+  ck_assert(close_recorder(&recorder, &live));
+  exit_game(&live);
+}
+
+START_TEST(test_seek_archive_basic) {
+  Replay_t replay;
+  Archive_t archive, reference;
+  ReplaySummary_t summary, result;
+  record_bot_game(31, 30);
+  ck_assert_int_eq(verify_replay(TEST_ARCHIVE_REPLAY, &summary, &result),
+                   Replay_valid);
+  ck_assert(load_replay(&replay, TEST_ARCHIVE_REPLAY));
+  ck_assert(create_archive(TEST_ARCHIVE_PATH, UINT32_MAX));
+  ck_assert(append_archive(TEST_ARCHIVE_PATH, &replay));
+  ck_assert(open_archive(&reference, TEST_ARCHIVE_PATH));
+  ck_assert(create_archive(TEST_ARCHIVE_PATH, 50));
+  ck_assert(append_archive(TEST_ARCHIVE_PATH, &replay));
+  ck_assert(append_archive(TEST_ARCHIVE_PATH, &replay));
+  ck_assert(open_archive(&archive, TEST_ARCHIVE_PATH));
+  ck_assert_uint_eq(archive.count, 2);
+  ck_assert_uint_eq(reference.entries[0]->keyframes, 1);
+
+  const ArchiveEntry_t *entry = archive.entries[1];
+  ck_assert_uint_eq(entry->ticks, summary.ticks);
+  ck_assert_uint_eq(entry->keyframes, (entry->ticks + 49) / 50);
+  ck_assert(entry->complete);
+  ck_assert_int_eq(entry->summary.score, summary.score);
+  ck_assert_uint_eq(find_keyframe(entry, 0)->tick, 0);
+  ck_assert_uint_eq(find_keyframe(entry, 149)->tick, 100);
+  ck_assert_uint_eq(find_keyframe(entry, 150)->tick, 150);
+  ck_assert_uint_eq(find_keyframe(entry, UINT64_MAX)->tick,
+                    50 * (entry->keyframes - 1));
+
+  const uint64_t ticks[] = {0, 1, 49, 50, 77, 333, entry->ticks - 1,
+                            entry->ticks, entry->ticks + 100};
+  for (int i = 0; i < 9; i++) {
+    ExpandedGameInfo_t fast, slow;
+    Save_t a, b;
+    ck_assert(seek_archive(&archive, 1, ticks[i], &fast));
+    ck_assert(seek_archive(&reference, 0, ticks[i], &slow));
+    save_game(&fast, &a);
+    save_game(&slow, &b);
+    ck_assert_mem_eq(&a, &b, sizeof(Save_t));
+    exit_game(&fast);
+    exit_game(&slow);
+  }
+  ExpandedGameInfo_t end;
+  ck_assert(seek_archive(&archive, 0, entry->ticks, &end));
+  ck_assert_int_eq(end.info.score, summary.score);
+  ck_assert_int_eq(end.lines, summary.lines);
+  exit_game(&end);
+  ck_assert(!seek_archive(&archive, 2, 0, &end));
+
+  close_archive(&archive);
+  close_archive(&reference);
+  free_replay(&replay);
+  remove(TEST_ARCHIVE_REPLAY);
+  remove(TEST_ARCHIVE_PATH);
+}
+END_TEST
+
+START_TEST(test_seek_archive_damaged) {
+  Replay_t replay;
+  Archive_t archive, reference;
+  record_bot_game(31, 30);
+  ck_assert(load_replay(&replay, TEST_ARCHIVE_REPLAY));
+  ck_assert(create_archive(TEST_ARCHIVE_PATH, UINT32_MAX));
+  ck_assert(append_archive(TEST_ARCHIVE_PATH, &replay));
+  ck_assert(open_archive(&reference, TEST_ARCHIVE_PATH));
+  ck_assert(create_archive(TEST_ARCHIVE_PATH, 50));
+  ck_assert(append_archive(TEST_ARCHIVE_PATH, &replay));
+  ck_assert(open_archive(&archive, TEST_ARCHIVE_PATH));
+  const Keyframe_t *keyframe = find_keyframe(archive.entries[0], 333);
+  long offset = (const char *)&keyframe->state.score - (char *)archive.map;
+  close_archive(&archive);
+  FILE *file = fopen(TEST_ARCHIVE_PATH, "r+b");
+  fseek(file, offset, SEEK_SET);
+  fputc(0x7f, file);
+  fclose(file);
+
+  ExpandedGameInfo_t fast, slow;
+  Save_t a, b;
+  ck_assert(open_archive(&archive, TEST_ARCHIVE_PATH));
+  ck_assert(seek_archive(&archive, 0, 333, &fast));
+  ck_assert(seek_archive(&reference, 0, 333, &slow));
+  save_game(&fast, &a);
+  save_game(&slow, &b);
+  ck_assert_mem_eq(&a, &b, sizeof(Save_t));
+  exit_game(&fast);
+  exit_game(&slow);
+
+  close_archive(&archive);
+  close_archive(&reference);
+  free_replay(&replay);
+  remove(TEST_ARCHIVE_REPLAY);
+  remove(TEST_ARCHIVE_PATH);
+}
+END_TEST
+
+START_TEST(test_append_archive_interrupted) {
+  Replay_t replay;
+  Archive_t archive;
+  record_bot_game(5, 3);
+  ck_assert(load_replay(&replay, TEST_ARCHIVE_REPLAY));
+  ck_assert(create_archive(TEST_ARCHIVE_PATH, 20));
+  ck_assert(append_archive(TEST_ARCHIVE_PATH, &replay));
+
+  FILE *file = fopen(TEST_ARCHIVE_PATH, "ab");
+  ck_assert_ptr_nonnull(file);
+  fprintf(file, "an entry that never got committed");
+  fclose(file);
+  ck_assert(open_archive(&archive, TEST_ARCHIVE_PATH));
+  ck_assert_uint_eq(archive.count, 1);
+  close_archive(&archive);
+
+  ck_assert(append_archive(TEST_ARCHIVE_PATH, &replay));
+  ck_assert(open_archive(&archive, TEST_ARCHIVE_PATH));
+  ck_assert_uint_eq(archive.count, 2);
+  ck_assert_uint_eq(archive.entries[1]->seed, 5);
+  ck_assert_uint_eq(archive.entries[1]->events, replay.size);
+  close_archive(&archive);
+  free_replay(&replay);
+  remove(TEST_ARCHIVE_REPLAY);
+  remove(TEST_ARCHIVE_PATH);
+}
+END_TEST
+
+START_TEST(test_open_archive_invalid) {
+  Archive_t archive;
+  Replay_t replay = {.data = NULL};
+  remove(TEST_ARCHIVE_PATH);
+  ck_assert(!open_archive(&archive, TEST_ARCHIVE_PATH));
+  ck_assert(!append_archive(TEST_ARCHIVE_PATH, &replay));
+  ck_assert(!create_archive(TEST_ARCHIVE_PATH, 0));
+
+  FILE *file = fopen(TEST_ARCHIVE_PATH, "wb");
+  ck_assert_ptr_nonnull(file);
+  fprintf(file, "TTRSRPLY and some more bytes than a header has.");
+  fclose(file);
+  ck_assert(!open_archive(&archive, TEST_ARCHIVE_PATH));
+  ck_assert_ptr_null(archive.map);
+
+  ck_assert(create_archive(TEST_ARCHIVE_PATH, 10));
+  file = fopen(TEST_ARCHIVE_PATH, "r+b");
+  ck_assert_ptr_nonnull(file);
+  uint64_t length = sizeof(ArchiveHeader_t) + sizeof(ArchiveEntry_t);
+  fseek(file, offsetof(ArchiveHeader_t, length), SEEK_SET);
+  fwrite(&length, sizeof(length), 1, file);
+  fclose(file);
+  ck_assert(!open_archive(&archive, TEST_ARCHIVE_PATH));
+  remove(TEST_ARCHIVE_PATH);
+}
+END_TEST
+
+Suite *suite_archive() {
+  Suite *s = suite_create("ARCHIVE");
+  TCase *tc = tcase_create("archive_tc");
+
+  // seek_archive
+  tcase_add_test(tc, test_seek_archive_basic);
+  tcase_add_test(tc, test_seek_archive_damaged);
+  // append_archive
+  tcase_add_test(tc, test_append_archive_interrupted);
+  // open_archive
+  tcase_add_test(tc, test_open_archive_invalid);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,99 @@
+#include "../brick_game/tetris/bot.h"
+#include "tetris_test.h"
+
+#define TEST_BOOK_PATH "test_book.bin"
+
+START_TEST(test_generate_book_basic) {
+  int count = generate_book(TEST_BOOK_PATH, 1);
+  Book_t book;
+
+  ck_assert_int_eq(count, PIECE_COUNT * PIECE_COUNT);
+  ck_assert(open_book(&book, TEST_BOOK_PATH));
+  ck_assert_int_eq(book.count, count);
+  for (size_t i = 1; i < book.count; i++) {
+    ck_assert(book.entries[i - 1].key < book.entries[i].key);
+  }
+
+  close_book(&book);
+  remove(TEST_BOOK_PATH);
+}
+END_TEST
+
+START_TEST(test_lookup_book_matches_search) {
+  generate_book(TEST_BOOK_PATH, 2);
+  Book_t book;
+  open_book(&book, TEST_BOOK_PATH);
+  Board_t board;
+  init_board(&board, NULL);
+  int queue[] = {7, 3};
+  Piece_t expected, found;
+
+  search_placement(&board.info, queue, 2, 0, &expected);
+
+  ck_assert(lookup_book(&book, get_position_key(&board.info, 7, 3), &found));
+  ck_assert_int_eq(found.pos, expected.pos);
+  ck_assert_int_eq(found.coords.row, expected.coords.row);
+  ck_assert_int_eq(found.coords.col, expected.coords.col);
+  ck_assert(!lookup_book(&book, 0, &found));
+
+  close_book(&book);
+  remove(TEST_BOOK_PATH);
+}
+END_TEST
+
+START_TEST(test_open_book_invalid) {
+  Book_t book;
+  FILE *file = fopen(TEST_BOOK_PATH, "w");
+  fprintf(file, "not a book at all");
+  fclose(file);
+
+  ck_assert(!open_book(&book, TEST_BOOK_PATH));
+  ck_assert_ptr_null(book.map);
+  ck_assert(!open_book(&book, "missing_book.bin"));
+
+  remove(TEST_BOOK_PATH);
+}
+END_TEST
+
+START_TEST(test_choose_placement_from_book) {
+  generate_book(TEST_BOOK_PATH, 1);
+  Book_t book;
+  open_book(&book, TEST_BOOK_PATH);
+  ExpandedGameInfo_t *info = get_instance();
+  clear_field(&info->info);
+  info->cur_piece = (Piece_t){4, {SPAWN_ROW, SPAWN_COL}, 0};
+  info->next_piece = (Piece_t){5, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info->info, info->cur_piece);
+  Piece_t from_book, searched;
+
+  ck_assert(choose_placement(info, &book, NULL, &from_book));
+  ck_assert(choose_placement(info, NULL, NULL, &searched));
+  ck_assert_int_eq(from_book.type, 4);
+  ck_assert_int_eq(from_book.pos, searched.pos);
+  ck_assert_int_eq(from_book.coords.col, searched.coords.col);
+
+  exit_game(info);
+  close_book(&book);
+  remove(TEST_BOOK_PATH);
+}
+END_TEST
+
+Suite *suite_book() {
+  Suite *s = suite_create("BOOK");
+  TCase *tc = tcase_create("book_tc");
+
+  // generate_book
+  tcase_add_test(tc, test_generate_book_basic);
+
+  // lookup_book
+  tcase_add_test(tc, test_lookup_book_matches_search);
+
+  // open_book
+  tcase_add_test(tc, test_open_book_invalid);
+
+  // choose_placement
+  tcase_add_test(tc, test_choose_placement_from_book);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,108 @@
+#include "../brick_game/tetris/bot.h"
+#include "tetris_test.h"
+
+START_TEST(test_evaluate_field_empty) {
+  Board_t board;
+  init_board(&board, NULL);
+
+  ck_assert(evaluate_field(&board.info, 0) == 0);
+}
+END_TEST
+
+START_TEST(test_evaluate_field_holes) {
+  Board_t flat, holed;
+  init_board(&flat, NULL);
+  init_board(&holed, NULL);
+  flat.cells[19][0] = 1;
+  flat.cells[19][1] = 1;
+  holed.cells[18][0] = 1;
+  holed.cells[18][1] = 1;
+
+  ck_assert(evaluate_field(&flat.info, 0) > evaluate_field(&holed.info, 0));
+}
+END_TEST
+
+START_TEST(test_list_placements_empty) {
+  Board_t board;
+  init_board(&board, NULL);
+  Piece_t placements[POS_COUNT * FIELD_COLS];
+
+  ck_assert_int_eq(list_placements(&board.info, 1, placements), 9);
+  ck_assert_int_eq(list_placements(&board.info, 2, placements), 17);
+  ck_assert_int_eq(list_placements(&board.info, 7, placements), 34);
+  ck_assert_int_eq(placements[0].coords.row, 18);
+}
+END_TEST
+
+START_TEST(test_search_placement_clears_row) {
+  Board_t board;
+  init_board(&board, NULL);
+  for (int j = 0; j < FIELD_COLS - 4; j++) {
+    board.cells[19][j] = 1;
+  }
+  int queue[] = {2};
+  Piece_t best;
+
+  search_placement(&board.info, queue, 1, 0, &best);
+
+  ck_assert_int_eq(best.coords.row, 19);
+  ck_assert_int_eq(best.coords.col, 8);
+  ck_assert_int_eq(best.pos % 2, 0);
+}
+END_TEST
+
+START_TEST(test_get_position_key_basic) {
+  Board_t board;
+  init_board(&board, NULL);
+  uint64_t empty = get_position_key(&board.info, 1, 2);
+  board.cells[19][0] = 4;
+  uint64_t filled = get_position_key(&board.info, 1, 2);
+  board.cells[19][0] = 6;
+
+  ck_assert(empty != filled);
+  ck_assert(filled == get_position_key(&board.info, 1, 2));
+  ck_assert(filled != get_position_key(&board.info, 2, 1));
+  ck_assert(get_zobrist_key(0) == get_zobrist_key(0));
+}
+END_TEST
+
+START_TEST(test_choose_placement_no_book) {
+  ExpandedGameInfo_t *info = get_instance();
+  clear_field(&info->info);
+  info->cur_piece = (Piece_t){1, {SPAWN_ROW, SPAWN_COL}, 0};
+  info->next_piece = (Piece_t){2, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info->info, info->cur_piece);
+  Piece_t target;
+
+  ck_assert(choose_placement(info, NULL, NULL, &target));
+  ck_assert_int_eq(target.type, 1);
+  ck_assert_int_eq(target.coords.row, 18);
+  ck_assert(is_piece_on_field(&info->info, info->cur_piece));
+
+  exit_game(info);
+}
+END_TEST
+
+Suite *suite_bot() {
+  Suite *s = suite_create("BOT");
+  TCase *tc = tcase_create("bot_tc");
+
+  // evaluate_field
+  tcase_add_test(tc, test_evaluate_field_empty);
+  tcase_add_test(tc, test_evaluate_field_holes);
+
+  // list_placements
+  tcase_add_test(tc, test_list_placements_empty);
+
+  // search_placement
+  tcase_add_test(tc, test_search_placement_clears_row);
+
+  // get_position_key
+  tcase_add_test(tc, test_get_position_key_basic);
+
+  // choose_placement
+  tcase_add_test(tc, test_choose_placement_no_book);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
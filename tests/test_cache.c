@@ -0,0 +1,150 @@
+#include "../brick_game/tetris/bot.h"
+#include "tetris_test.h"
+
+#define TEST_CACHE_PATH "test_cache.bin"
+
+START_TEST(test_store_cache_basic) {
+  remove(TEST_CACHE_PATH);
+  Cache_t cache;
+  CacheEntry_t entry = {.score = -12.5f, .best = {7, {18, 3}, 2}}, found;
+
+  ck_assert(open_cache(&cache, TEST_CACHE_PATH, 100));
+  ck_assert_int_eq(cache.count, 128);
+  ck_assert(!probe_cache(&cache, 42, &found));
+
+  store_cache(&cache, 42, &entry);
+
+  ck_assert(probe_cache(&cache, 42, &found));
+  ck_assert(found.score == entry.score);
+  ck_assert_int_eq(found.best.type, 7);
+  ck_assert_int_eq(found.best.coords.row, 18);
+  ck_assert_int_eq(found.best.coords.col, 3);
+  ck_assert_int_eq(found.best.pos, 2);
+
+  close_cache(&cache);
+  remove(TEST_CACHE_PATH);
+}
+END_TEST
+
+START_TEST(test_open_cache_persistent) {
+  remove(TEST_CACHE_PATH);
+  Cache_t cache;
+  CacheEntry_t entry = {.score = 3.0f, .best = {1, {18, 1}, 0}}, found;
+
+  open_cache(&cache, TEST_CACHE_PATH, 64);
+  store_cache(&cache, 1234567, &entry);
+  uint16_t generation = cache.generation;
+  close_cache(&cache);
+
+  ck_assert(open_cache(&cache, TEST_CACHE_PATH, 1024));
+  ck_assert_int_eq(cache.count, 64);
+  ck_assert_int_eq(cache.generation, generation + 1);
+  ck_assert(probe_cache(&cache, 1234567, &found));
+  ck_assert(found.score == 3.0f);
+
+  close_cache(&cache);
+  remove(TEST_CACHE_PATH);
+}
+END_TEST
+
+START_TEST(test_store_cache_eviction) {
+  remove(TEST_CACHE_PATH);
+  Cache_t cache;
+  CacheEntry_t entry = {.score = 1.0f, .best = {2, {19, 4}, 0}}, found;
+
+  open_cache(&cache, TEST_CACHE_PATH, CACHE_BUCKET);
+  store_cache(&cache, 1, &entry);
+  close_cache(&cache);
+  open_cache(&cache, TEST_CACHE_PATH, CACHE_BUCKET);
+  for (uint64_t key = 2; key <= CACHE_BUCKET + 1; key++) {
+    store_cache(&cache, key, &entry);
+  }
+
+  ck_assert(!probe_cache(&cache, 1, &found));
+  for (uint64_t key = 2; key <= CACHE_BUCKET + 1; key++) {
+    ck_assert(probe_cache(&cache, key, &found));
+  }
+
+  close_cache(&cache);
+  remove(TEST_CACHE_PATH);
+}
+END_TEST
+
+START_TEST(test_probe_cache_torn_slot) {
+  remove(TEST_CACHE_PATH);
+  Cache_t cache;
+  CacheEntry_t entry = {.score = 1.0f, .best = {2, {19, 4}, 0}}, found;
+
+  open_cache(&cache, TEST_CACHE_PATH, CACHE_BUCKET);
+  store_cache(&cache, 5, &entry);
+  atomic_fetch_xor(&cache.slots[0].data, 1);
+
+  ck_assert(!probe_cache(&cache, 5, &found));
+
+  close_cache(&cache);
+  remove(TEST_CACHE_PATH);
+}
+END_TEST
+
+START_TEST(test_open_cache_invalid) {
+  Cache_t cache;
+  FILE *file = fopen(TEST_CACHE_PATH, "w");
+  fprintf(file, "definitely not a cache file");
+  fclose(file);
+
+  ck_assert(!open_cache(&cache, TEST_CACHE_PATH, CACHE_SLOTS));
+  ck_assert_ptr_null(cache.map);
+
+  remove(TEST_CACHE_PATH);
+}
+END_TEST
+
+START_TEST(test_choose_placement_cached) {
+  remove(TEST_CACHE_PATH);
+  Cache_t cache;
+  open_cache(&cache, TEST_CACHE_PATH, CACHE_SLOTS);
+  ExpandedGameInfo_t *info = get_instance();
+  clear_field(&info->info);
+  info->cur_piece = (Piece_t){6, {SPAWN_ROW, SPAWN_COL}, 0};
+  info->next_piece = (Piece_t){2, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info->info, info->cur_piece);
+  Piece_t searched, cached;
+  CacheEntry_t found;
+
+  ck_assert(choose_placement(info, NULL, &cache, &searched));
+  remove_piece(&info->info, info->cur_piece);
+  ck_assert(probe_cache(&cache, get_position_key(&info->info, 6, 2), &found));
+  place_piece(&info->info, info->cur_piece);
+  ck_assert(choose_placement(info, NULL, &cache, &cached));
+  ck_assert_int_eq(cached.type, searched.type);
+  ck_assert_int_eq(cached.pos, searched.pos);
+  ck_assert_int_eq(cached.coords.row, searched.coords.row);
+  ck_assert_int_eq(cached.coords.col, searched.coords.col);
+
+  exit_game(info);
+  close_cache(&cache);
+  remove(TEST_CACHE_PATH);
+}
+END_TEST
+
+Suite *suite_cache() {
+  Suite *s = suite_create("CACHE");
+  TCase *tc = tcase_create("cache_tc");
+
+  // store_cache
+  tcase_add_test(tc, test_store_cache_basic);
+  tcase_add_test(tc, test_store_cache_eviction);
+
+  // open_cache
+  tcase_add_test(tc, test_open_cache_persistent);
+  tcase_add_test(tc, test_open_cache_invalid);
+
+  // probe_cache
+  tcase_add_test(tc, test_probe_cache_torn_slot);
+
+  // choose_placement
+  tcase_add_test(tc, test_choose_placement_cached);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
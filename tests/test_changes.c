@@ -0,0 +1,111 @@
+#include "tetris_test.h"
+
+START_TEST(test_get_changes_created) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+
+  Changes_t changes = get_changes(&info);
+  ck_assert_uint_eq(changes.rows, FIELD_ROWS_MASK);
+  ck_assert(changes.next);
+  ck_assert(changes.fields & Score_changed);
+  reset_changes(&info);
+  changes = get_changes(&info);
+  ck_assert_uint_eq(changes.rows, 0);
+  ck_assert_uint_eq(changes.fields, 0);
+  ck_assert(!changes.next);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_get_changes_move) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  info.state = Play;
+  info.cur_piece = (Piece_t){2, {5, SPAWN_COL}, 0};
+  place_piece(&info.info, info.cur_piece);
+  reset_changes(&info);
+
+  process_action(&info, Right);
+  Changes_t changes = get_changes(&info);
+  ck_assert_uint_eq(changes.rows, 1u << 5);
+  ck_assert_uint_eq(changes.fields, 0);
+  ck_assert(!changes.next);
+
+  reset_changes(&info);
+  process_action(&info, Down);
+  ck_assert_uint_eq(get_changes(&info).rows, 3u << 5);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_get_changes_idle) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  info.state = Play;
+  info.timer = 5 * DELAY;
+  info.cur_piece = (Piece_t){2, {5, SPAWN_COL}, 0};
+  place_piece(&info.info, info.cur_piece);
+  reset_changes(&info);
+
+  process_input(&info, -1, false);
+  Changes_t changes = get_changes(&info);
+  ck_assert_uint_eq(changes.rows, 0);
+  ck_assert_uint_eq(changes.fields, 0);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_get_changes_clear) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  info.state = Play;
+  for (int j = 0; j < FIELD_COLS - 1; j++) info.info.field[19][j] = 1;
+  info.info.field[18][0] = 1;
+  info.cur_piece = (Piece_t){2, {10, 9}, 1};
+  info.next_piece = (Piece_t){1, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info.info, info.cur_piece);
+  reset_changes(&info);
+
+  process_action(&info, Up);
+  ck_assert_uint_eq(get_changes(&info).rows, 0xfu << 16 | 0xfu << 9);
+  ck_assert_uint_eq(get_changes(&info).fields, 0);
+  info.timer = DELAY;
+  reset_changes(&info);
+  process_input(&info, -1, false);
+  Changes_t changes = get_changes(&info);
+  ck_assert_uint_eq(info.info.field[19][0], 1);
+  ck_assert_uint_eq(info.info.field[19][1], 0);
+  ck_assert_uint_eq(changes.rows & (1u << 19), 1u << 19);
+  ck_assert_uint_eq(changes.rows & 1u, 1u);
+  ck_assert(changes.fields & Score_changed);
+  ck_assert(!(changes.fields & Pause_changed));
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_get_changes_pause) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  info.state = Play;
+  reset_changes(&info);
+
+  process_action(&info, Pause);
+  ck_assert_uint_eq(get_changes(&info).fields, Pause_changed);
+  exit_game(&info);
+}
+END_TEST
+
+Suite *suite_changes() {
+  Suite *s = suite_create("CHANGES");
+  TCase *tc = tcase_create("changes_tc");
+
+  // get_changes
+  tcase_add_test(tc, test_get_changes_created);
+  tcase_add_test(tc, test_get_changes_move);
+  tcase_add_test(tc, test_get_changes_idle);
+  tcase_add_test(tc, test_get_changes_clear);
+  tcase_add_test(tc, test_get_changes_pause);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -1,5 +1,10 @@
+#include "../brick_game/tetris/notation.h"
 #include "tetris_test.h"
 
+static const char *filled_position =
+    "0000000000000000000000000000000000000000000000000003ff3ff3ff "
+    "123456712345671234567123456777 3:0:5:0 4 0 1 0";
+
 START_TEST(test_exit_game_field_not_null) {
   ExpandedGameInfo_t info = {.info = {NULL, NULL, 0, 0, 1, 1, 0},
                              .cur_piece = {0, {0, 0}, 0},
@@ -56,44 +61,68 @@ START_TEST(test_reset_game_basic) {
     info.info.next[i] = calloc(NEXT_COLS, sizeof(int));
   }
 
+  info.rng = 42;
+  uint64_t rng = 42;
+  next_random(&rng);
+  next_random(&rng);
   reset_game(&info);
 
-  ck_assert_ptr_null(info.info.field);
-  ck_assert_ptr_null(info.info.next);
-
-  ExpandedGameInfo_t *instance = get_instance();
-  exit_game(instance);
+  ck_assert_ptr_nonnull(info.info.field);
+  ck_assert_ptr_nonnull(info.info.next);
+  ck_assert_int_eq(info.info.score, 0);
+  ck_assert_int_eq(info.state, Begin);
+  ck_assert_uint_eq(info.seed, 42);
+  ck_assert_uint_eq(info.rng, rng);
+  exit_game(&info);
 }
 END_TEST
 
-START_TEST(test_clear_field_basic) {
-  GameInfo_t info = {.field = malloc(FIELD_ROWS * sizeof(int *)),
-                     .next = NULL,
-                     .score = 0,
-                     .high_score = 0,
-                     .level = 1,
-                     .speed = 1,
-                     .pause = 0};
+START_TEST(test_reset_game_in_place) {
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 12);
+  GameStorage_t *storage = info.storage;
+  int **field = info.info.field;
+  process_action(&info, Start);
+  for (int i = 0; i < 5; i++) {
+    process_action(&info, Up);
+    skip_ticks(&info, 1000);
+    process_input(&info, -1, false);
+  }
+  reset_game(&info);
 
+  ck_assert_ptr_eq(info.storage, storage);
+  ck_assert_ptr_eq(info.info.field, field);
+  ck_assert_ptr_eq(info.info.field[FIELD_ROWS - 1], storage->cells[19]);
   for (int i = 0; i < FIELD_ROWS; i++) {
-    info.field[i] = malloc(FIELD_COLS * sizeof(int));
-    for (int j = 0; j < FIELD_COLS; j++) {
-      info.field[i][j] = 1;
-    }
+    for (int j = 0; j < FIELD_COLS; j++) ck_assert_int_eq(field[i][j], 0);
   }
+  ck_assert_int_eq(info.state, Begin);
+  ck_assert_int_eq(info.lines, 0);
+  exit_game(&info);
+  ck_assert_ptr_null(info.storage);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_clear_field_basic) {
+  ExpandedGameInfo_t info;
+  Position_t position;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 1);
+  ck_assert_ptr_nonnull(parse_position(filled_position, &position));
+  restore_position(&info, &position);
+  ck_assert_int_eq(info.info.field[FIELD_ROWS - 1][0], 7);
 
-  clear_field(&info);
+  clear_field(&info.info);
 
   for (int i = 0; i < FIELD_ROWS; i++) {
     for (int j = 0; j < FIELD_COLS; j++) {
-      ck_assert_int_eq(info.field[i][j], 0);
+      ck_assert_int_eq(info.info.field[i][j], 0);
     }
   }
-
-  for (int i = 0; i < FIELD_ROWS; i++) {
-    free(info.field[i]);
-  }
-  free(info.field);
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
 }
 END_TEST
 
@@ -107,6 +136,7 @@ Suite *suite_clearing() {
 
   // reset_game
   tcase_add_test(tc, test_reset_game_basic);
+  tcase_add_test(tc, test_reset_game_in_place);
 
   // clear_field
   tcase_add_test(tc, test_clear_field_basic);
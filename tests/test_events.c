@@ -0,0 +1,122 @@
+#include "tetris_test.h"
+
+#define TEST_EVENTS_PIECES 60
+#define TEST_EVENTS_LOG 512
+
+typedef struct {
+  GameEvent_t events[TEST_EVENTS_LOG];
+  int values[TEST_EVENTS_LOG];
+  int count;
+} EventLog_t;
+
+static void log_event(void *context, const GameInfo_t *info,
+                      GameEvent_t event, int value) {
+  EventLog_t *log = context;
+  (void)info;
+  if (log->count < TEST_EVENTS_LOG) {
+    log->events[log->count] = event;
+    log->values[log->count++] = value;
+  }
+}
+
+START_TEST(test_emit_event_order) {
+  static EventLog_t log;
+  EventBus_t bus = {.count = 0};
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 77);
+  info.bus = &bus;
+  log.count = 0;
+  ck_assert(subscribe_events(&bus, log_event, &log, ~0u));
+  process_action(&info, Start);
+  for (int i = 0; i < TEST_EVENTS_PIECES && info.state != Game_over; i++) {
+    int count = log.count;
+    steer_bot_piece(&info);
+    process_action(&info, Up);
+    ck_assert_int_eq(log.count, count);
+    skip_ticks(&info, 1000);
+    process_input(&info, -1, false);
+  }
+
+  int locks = 0, lines = 0, level = INIT_LEVEL;
+  for (int i = 0; i < log.count; i++) {
+    GameEvent_t event = log.events[i];
+    if (event == Piece_locked) locks++;
+    if (event == Rows_cleared) lines += log.values[i];
+    if (event == Level_up) level = log.values[i];
+    if (event != Piece_locked) ck_assert(i > 0);
+    if (event == Rows_cleared) ck_assert(log.events[i - 1] == Piece_locked);
+    if (event == Level_up) ck_assert(log.events[i - 1] == Rows_cleared);
+  }
+  ck_assert_int_eq(locks, TEST_EVENTS_PIECES);
+  ck_assert_int_gt(lines, 0);
+  ck_assert_int_eq(lines, info.lines);
+  ck_assert_int_eq(level, info.info.level);
+  ck_assert_int_eq(log.events[log.count - 1], Piece_spawned);
+  ck_assert_int_eq(log.values[log.count - 1], info.cur_piece.type);
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_emit_event_top_out) {
+  static EventLog_t log, ends;
+  EventBus_t bus = {.count = 0};
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 3);
+  info.bus = &bus;
+  log.count = ends.count = 0;
+  ck_assert(subscribe_events(&bus, log_event, &log, ~0u));
+  ck_assert(subscribe_events(&bus, log_event, &ends, 1u << Topped_out));
+  process_action(&info, Start);
+  int locks = 0;
+  while (info.state != Game_over && locks < 100) {
+    process_action(&info, Up);
+    skip_ticks(&info, 1000);
+    process_input(&info, -1, false);
+    locks++;
+  }
+  ck_assert_int_eq(info.state, Game_over);
+  ck_assert_int_eq(ends.count, 1);
+  ck_assert_int_eq(ends.values[0], info.info.score);
+  ck_assert_int_eq(log.events[log.count - 1], Topped_out);
+  ck_assert_int_eq(log.events[log.count - 2], Piece_locked);
+
+  unsubscribe_events(&bus, log_event, &log);
+  ck_assert_int_eq(bus.count, 1);
+  process_action(&info, Start);
+  ck_assert_int_eq(info.state, Play);
+  ck_assert_ptr_eq(info.bus, &bus);
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_subscribe_events_full) {
+  EventLog_t logs[EVENT_SUBSCRIBERS + 1];
+  EventBus_t bus = {.count = 0};
+  for (int i = 0; i < EVENT_SUBSCRIBERS; i++) {
+    ck_assert(subscribe_events(&bus, log_event, &logs[i], ~0u));
+  }
+  ck_assert(!subscribe_events(&bus, log_event, &logs[EVENT_SUBSCRIBERS], ~0u));
+  unsubscribe_events(&bus, log_event, &logs[2]);
+  ck_assert_int_eq(bus.count, EVENT_SUBSCRIBERS - 1);
+  ck_assert_ptr_eq(bus.subscribers[2].context, &logs[3]);
+  ck_assert(subscribe_events(&bus, log_event, &logs[EVENT_SUBSCRIBERS], ~0u));
+}
+END_TEST
+
+Suite *suite_events() {
+  Suite *s = suite_create("EVENTS");
+  TCase *tc = tcase_create("events_tc");
+
+  // emit_event
+  tcase_add_test(tc, test_emit_event_order);
+  tcase_add_test(tc, test_emit_event_top_out);
+  // subscribe_events
+  tcase_add_test(tc, test_subscribe_events_full);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,170 @@
+#include "../brick_game/tetris/finesse.h"
+#include "tetris_test.h"
+
+START_TEST(test_get_table_path_spawn_column) {
+  const Path_t *path = get_table_path(1, 0, SPAWN_COL);
+
+  ck_assert_int_eq(path->length, 1);
+  ck_assert_int_eq(path->keys[0], Up);
+}
+END_TEST
+
+START_TEST(test_get_table_path_left_wall) {
+  const Path_t *path = get_table_path(1, 0, 1);
+
+  ck_assert_int_eq(path->length, 5);
+  for (int i = 0; i < 4; i++) {
+    ck_assert_int_eq(path->keys[i], Left);
+  }
+  ck_assert_int_eq(path->keys[4], Up);
+}
+END_TEST
+
+START_TEST(test_get_table_path_out_of_field) {
+  const Path_t *path = get_table_path(1, 0, 0);
+
+  ck_assert_int_eq(path->length, -1);
+}
+END_TEST
+
+START_TEST(test_get_table_path_ends_with_drop) {
+  for (int type = 1; type <= PIECE_COUNT; type++) {
+    for (int pos = 0; pos < POS_COUNT; pos++) {
+      for (int col = 0; col < FIELD_COLS; col++) {
+        const Path_t *path = get_table_path(type, pos, col);
+        if (path->length > 0) {
+          ck_assert_int_eq(path->keys[path->length - 1], Up);
+        }
+      }
+    }
+  }
+}
+END_TEST
+
+START_TEST(test_search_path_tuck) {
+  GameInfo_t info;
+  info.field = calloc(FIELD_ROWS, sizeof(int *));
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    info.field[i] = calloc(FIELD_COLS, sizeof(int));
+  }
+  info.field[17][0] = 2;
+  info.field[17][1] = 2;
+
+  Piece_t start = {.type = 1, .pos = 0, .coords = {SPAWN_ROW, SPAWN_COL}};
+  Piece_t target = {.type = 1, .pos = 0, .coords = {18, 1}};
+  Path_t path;
+
+  ck_assert(search_path(&info, start, target, &path));
+  ck_assert(follow_path(&info, start, &path, target));
+  ck_assert_int_eq(path.keys[path.length - 1], Left);
+
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    free(info.field[i]);
+  }
+  free(info.field);
+}
+END_TEST
+
+START_TEST(test_search_path_unreachable) {
+  GameInfo_t info;
+  info.field = calloc(FIELD_ROWS, sizeof(int *));
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    info.field[i] = calloc(FIELD_COLS, sizeof(int));
+  }
+  for (int j = 0; j < FIELD_COLS; j++) {
+    info.field[10][j] = 2;
+  }
+
+  Piece_t start = {.type = 1, .pos = 0, .coords = {SPAWN_ROW, SPAWN_COL}};
+  Piece_t target = {.type = 1, .pos = 0, .coords = {18, 5}};
+  Path_t path;
+
+  ck_assert(!search_path(&info, start, target, &path));
+  ck_assert_int_eq(path.length, -1);
+
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    free(info.field[i]);
+  }
+  free(info.field);
+}
+END_TEST
+
+START_TEST(test_find_path_symmetric_rotation) {
+  ExpandedGameInfo_t *info = get_instance();
+  clear_field(&info->info);
+  info->cur_piece = (Piece_t){3, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info->info, info->cur_piece);
+
+  Piece_t target = {.type = 3, .pos = 2, .coords = {18, 2}};
+  Path_t path;
+
+  ck_assert(find_path(info, target, &path));
+  ck_assert_int_eq(path.length, 4);
+  ck_assert(is_piece_on_field(&info->info, info->cur_piece));
+
+  for (int i = 0; i < path.length; i++) {
+    make_move(info, path.keys[i]);
+  }
+  ck_assert(is_same_placement(info->cur_piece, target));
+
+  exit_game(info);
+}
+END_TEST
+
+START_TEST(test_find_path_obstructed_table) {
+  ExpandedGameInfo_t *info = get_instance();
+  clear_field(&info->info);
+  info->info.field[3][1] = 2;
+  info->cur_piece = (Piece_t){1, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info->info, info->cur_piece);
+
+  Piece_t target = {.type = 1, .pos = 0, .coords = {18, 1}};
+  Path_t path;
+
+  ck_assert(find_path(info, target, &path));
+  ck_assert_int_eq(path.length, 5);
+  ck_assert_int_eq(path.keys[path.length - 1], Left);
+
+  for (int i = 0; i < path.length; i++) {
+    make_move(info, path.keys[i]);
+  }
+  ck_assert(is_same_placement(info->cur_piece, target));
+
+  exit_game(info);
+}
+END_TEST
+
+START_TEST(test_is_same_placement_basic) {
+  Piece_t a = {.type = 2, .pos = 0, .coords = {5, 5}};
+  Piece_t b = {.type = 2, .pos = 2, .coords = {5, 5}};
+  Piece_t c = {.type = 2, .pos = 1, .coords = {5, 5}};
+
+  ck_assert(is_same_placement(a, b));
+  ck_assert(!is_same_placement(a, c));
+}
+END_TEST
+
+Suite *suite_finesse() {
+  Suite *s = suite_create("FINESSE");
+  TCase *tc = tcase_create("finesse_tc");
+
+  // get_table_path
+  tcase_add_test(tc, test_get_table_path_spawn_column);
+  tcase_add_test(tc, test_get_table_path_left_wall);
+  tcase_add_test(tc, test_get_table_path_out_of_field);
+  tcase_add_test(tc, test_get_table_path_ends_with_drop);
+
+  // search_path
+  tcase_add_test(tc, test_search_path_tuck);
+  tcase_add_test(tc, test_search_path_unreachable);
+
+  // find_path
+  tcase_add_test(tc, test_find_path_symmetric_rotation);
+  tcase_add_test(tc, test_find_path_obstructed_table);
+
+  // is_same_placement
+  tcase_add_test(tc, test_is_same_placement_basic);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,216 @@
+#ifndef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 500
+#endif
+
+#include <sys/wait.h>
+
+#include "../brick_game/tetris/leaderboard.h"
+#include "tetris_test.h"
+
+#define TEST_LEADERBOARD_PATH "test_leaderboard.bin"
+#define TEST_LEADERBOARD_LINK "test_leaderboard.lnk"
+#define TEST_LEADERBOARD_THREADS 4
+#define TEST_LEADERBOARD_GAMES 100
+
+START_TEST(test_submit_score_basic) {
+  Leaderboard_t board;
+  LeaderEntry_t entries[LEADERBOARD_SIZE];
+  remove(TEST_LEADERBOARD_PATH);
+  ck_assert(open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  ck_assert_int_eq(read_leaderboard(&board, entries), 0);
+
+  LeaderEntry_t ann = {500, 5, 1, 0, 10, "ann"};
+  LeaderEntry_t bob = {900, 9, 2, 0, 20, "bob"};
+  LeaderEntry_t eve = {500, 4, 1, 0, 5, "eve"};
+  ck_assert_int_eq(submit_score(&board, &ann), 0);
+  ck_assert_int_eq(submit_score(&board, &bob), 0);
+  ck_assert_int_eq(submit_score(&board, &eve), 1);
+  ck_assert_int_eq(read_leaderboard(&board, entries), 3);
+  ck_assert_str_eq(entries[0].tag, "bob");
+  ck_assert_str_eq(entries[1].tag, "eve");
+  ck_assert_str_eq(entries[2].tag, "ann");
+
+  for (int i = 0; i < LEADERBOARD_SIZE; i++) {
+    LeaderEntry_t entry = {1000 + i, i, 3, 0, 30 + i, "max"};
+    submit_score(&board, &entry);
+  }
+  ck_assert_int_eq(read_leaderboard(&board, entries), LEADERBOARD_SIZE);
+  ck_assert_int_eq(entries[0].score, 1000 + LEADERBOARD_SIZE - 1);
+  ck_assert_int_eq(entries[LEADERBOARD_SIZE - 1].score, 1000);
+  LeaderEntry_t late = {1000, 0, 1, 0, 99, "sam"};
+  ck_assert_int_eq(submit_score(&board, &late), -1);
+  close_leaderboard(&board);
+
+  ck_assert(open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  ck_assert_int_eq(read_leaderboard(&board, entries), LEADERBOARD_SIZE);
+  ck_assert_int_eq(entries[0].score, 1000 + LEADERBOARD_SIZE - 1);
+  close_leaderboard(&board);
+  remove(TEST_LEADERBOARD_PATH);
+}
+END_TEST
+
+START_TEST(test_lock_leaderboard_stale) {
+  Leaderboard_t board;
+  LeaderEntry_t entries[LEADERBOARD_SIZE];
+  remove(TEST_LEADERBOARD_PATH);
+  ck_assert(open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  LeaderEntry_t ann = {300, 3, 1, 0, 1, "ann"};
+  submit_score(&board, &ann);
+
+  pid_t child = fork();
+  if (child == 0) {
+    LeaderboardFile_t *file = board.file;
+    if (!lock_leaderboard(&board)) _exit(1);
+    uint32_t active = atomic_load(&file->active);
+    atomic_fetch_add(&file->sequence, 1);
+    memset(&file->tables[1 - active], 0xff, sizeof(LeaderTable_t));
+    _exit(0);
+  }
+  ck_assert_int_gt(child, 0);
+  int status;
+  waitpid(child, &status, 0);
+  ck_assert_int_eq(WEXITSTATUS(status), 0);
+
+  ck_assert_int_eq(read_leaderboard(&board, entries), 1);
+  ck_assert_int_eq(entries[0].score, 300);
+  LeaderEntry_t entry = {700, 7, 1, 0, 2, "bob"};
+  ck_assert_int_eq(submit_score(&board, &entry), 0);
+  ck_assert_int_eq(read_leaderboard(&board, entries), 2);
+  ck_assert_int_eq(entries[1].score, 300);
+  close_leaderboard(&board);
+  remove(TEST_LEADERBOARD_PATH);
+}
+END_TEST
+
+START_TEST(test_lock_leaderboard_timeout) {
+  Leaderboard_t board;
+  LeaderEntry_t entries[LEADERBOARD_SIZE];
+  int held[2], done[2];
+  char byte = 0;
+  remove(TEST_LEADERBOARD_PATH);
+  ck_assert(open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  ck_assert_int_eq(pipe(held), 0);
+  ck_assert_int_eq(pipe(done), 0);
+
+  pid_t child = fork();
+  if (child == 0) {
+    if (!lock_leaderboard(&board)) _exit(1);
+    if (write(held[1], &byte, 1) != 1 || read(done[0], &byte, 1) != 1)
+      _exit(1);
+    _exit(0);
+  }
+  ck_assert_int_gt(child, 0);
+  ck_assert_int_eq(read(held[0], &byte, 1), 1);
+  LeaderEntry_t ann = {300, 3, 1, 0, 1, "ann"};
+  ck_assert_int_eq(submit_score(&board, &ann), -1);
+  ck_assert_int_eq(read_leaderboard(&board, entries), 0);
+  ck_assert_int_eq(write(done[1], &byte, 1), 1);
+  waitpid(child, NULL, 0);
+  ck_assert_int_eq(submit_score(&board, &ann), 0);
+  for (int i = 0; i < 2; i++) {
+    close(held[i]);
+    close(done[i]);
+  }
+  close_leaderboard(&board);
+  remove(TEST_LEADERBOARD_PATH);
+}
+END_TEST
+
+void *submit_test_scores(void *arg) {
+  Leaderboard_t *board = arg;
+  uint32_t score = (uint32_t)(uintptr_t)pthread_self();
+  for (int i = 0; i < TEST_LEADERBOARD_GAMES; i++) {
+    score = score * 1103515245u + 12345u;
+    LeaderEntry_t entry = {(int32_t)(score % 100000), i, 1, 0, i, "bot"};
+    submit_score(board, &entry);
+    LeaderEntry_t entries[LEADERBOARD_SIZE];
+    int count = read_leaderboard(board, entries);
+    for (int j = 1; j < count; j++) {
+      if (ranks_above(&entries[j], &entries[j - 1])) return board;
+    }
+  }
+  return NULL;
+}
+
+START_TEST(test_submit_score_concurrent) {
+  Leaderboard_t board;
+  LeaderEntry_t entries[LEADERBOARD_SIZE];
+  remove(TEST_LEADERBOARD_PATH);
+  ck_assert(open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  pthread_t threads[TEST_LEADERBOARD_THREADS];
+  for (int i = 0; i < TEST_LEADERBOARD_THREADS; i++) {
+    pthread_create(&threads[i], NULL, submit_test_scores, &board);
+  }
+  for (int i = 0; i < TEST_LEADERBOARD_THREADS; i++) {
+    void *res;
+    pthread_join(threads[i], &res);
+    ck_assert_ptr_null(res);
+  }
+  ck_assert_int_eq(read_leaderboard(&board, entries), LEADERBOARD_SIZE);
+  close_leaderboard(&board);
+  remove(TEST_LEADERBOARD_PATH);
+}
+END_TEST
+
+START_TEST(test_open_leaderboard_shared) {
+  Leaderboard_t board;
+  struct stat st;
+  remove(TEST_LEADERBOARD_PATH);
+  mode_t mask = umask(022);
+  ck_assert(open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  umask(mask);
+  close_leaderboard(&board);
+  ck_assert_int_eq(stat(TEST_LEADERBOARD_PATH, &st), 0);
+  ck_assert_int_eq(st.st_mode & 0777, LEADERBOARD_MODE & ~022);
+  ck_assert_int_eq(symlink(TEST_LEADERBOARD_PATH, TEST_LEADERBOARD_LINK), 0);
+  ck_assert(!open_leaderboard(&board, TEST_LEADERBOARD_LINK));
+  ck_assert_ptr_null(board.file);
+  remove(TEST_LEADERBOARD_LINK);
+  remove(TEST_LEADERBOARD_PATH);
+
+  static char set[] = LEADERBOARD_ENV "=" TEST_LEADERBOARD_PATH;
+  static char unset[] = LEADERBOARD_ENV "=";
+  putenv(set);
+  ck_assert_str_eq(get_leaderboard_path(), TEST_LEADERBOARD_PATH);
+  putenv(unset);
+  ck_assert_str_eq(get_leaderboard_path(), LEADERBOARD_PATH);
+}
+END_TEST
+
+START_TEST(test_open_leaderboard_invalid) {
+  Leaderboard_t board;
+  FILE *file = fopen(TEST_LEADERBOARD_PATH, "w");
+  fputs("not a leaderboard", file);
+  fclose(file);
+  ck_assert(!open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  ck_assert_ptr_null(board.file);
+  remove(TEST_LEADERBOARD_PATH);
+
+  LeaderEntry_t entries[LEADERBOARD_SIZE];
+  LeaderEntry_t ann = {300, 3, 1, 0, 1, "ann"};
+  ck_assert(open_leaderboard(&board, TEST_LEADERBOARD_PATH));
+  submit_score(&board, &ann);
+  ck_assert_int_eq(truncate(TEST_LEADERBOARD_PATH, 8), 0);
+  ck_assert_int_eq(read_leaderboard(&board, entries), 0);
+  close_leaderboard(&board);
+  remove(TEST_LEADERBOARD_PATH);
+}
+END_TEST
+
+Suite *suite_leaderboard() {
+  Suite *s = suite_create("LEADERBOARD");
+  TCase *tc = tcase_create("leaderboard_tc");
+
+  // submit_score
+  tcase_add_test(tc, test_submit_score_basic);
+  tcase_add_test(tc, test_submit_score_concurrent);
+  // lock_leaderboard
+  tcase_add_test(tc, test_lock_leaderboard_stale);
+  tcase_add_test(tc, test_lock_leaderboard_timeout);
+  // open_leaderboard
+  tcase_add_test(tc, test_open_leaderboard_shared);
+  tcase_add_test(tc, test_open_leaderboard_invalid);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,202 @@
+#include "../brick_game/tetris/notation.h"
+#include "tetris_test.h"
+
+static const char *sample =
+    "0000000000000000000000000000000000000000000000000000001fb3ff "
+    "123456712345671237 3:4:5:1 6 1200 3 120";
+
+START_TEST(test_parse_position_basic) {
+  Position_t position;
+
+  const char *end = parse_position(sample, &position);
+  ck_assert_ptr_nonnull(end);
+  ck_assert_int_eq(*end, '\0');
+  ck_assert_int_eq(position.cells[18][0], 1);
+  ck_assert_int_eq(position.cells[18][1], 2);
+  ck_assert_int_eq(position.cells[18][2], 0);
+  ck_assert_int_eq(position.cells[19][9], 7);
+  ck_assert_int_eq(position.cells[17][0], 0);
+  ck_assert_int_eq(position.cur.type, 3);
+  ck_assert_int_eq(position.cur.coords.row, 4);
+  ck_assert_int_eq(position.cur.coords.col, 5);
+  ck_assert_int_eq(position.cur.pos, 1);
+  ck_assert_int_eq(position.next, 6);
+  ck_assert_int_eq(position.score, 1200);
+  ck_assert_int_eq(position.level, 3);
+  ck_assert_int_eq(position.timer, 120);
+}
+END_TEST
+
+START_TEST(test_parse_position_invalid) {
+  Position_t position;
+  char text[POSITION_TEXT];
+
+  ck_assert_ptr_null(parse_position("00g", &position));
+  strcpy(text, sample);
+  text[54] = '8';
+  ck_assert_ptr_null(parse_position(text, &position));
+  strcpy(text, sample);
+  text[67] = '9';
+  ck_assert_ptr_null(parse_position(text, &position));
+  strcpy(text, sample);
+  text[80] = '8';
+  ck_assert_ptr_null(parse_position(text, &position));
+  strcpy(text, sample);
+  strcpy(strstr(text, "1200"), "99999999999 3 120");
+  ck_assert_ptr_null(parse_position(text, &position));
+  strcpy(text, sample);
+  strcpy(strstr(text, "1200"), "1200 11 120");
+  ck_assert_ptr_null(parse_position(text, &position));
+  strcpy(strstr(text, "1200"), "1200 256 120");
+  ck_assert_ptr_null(parse_position(text, &position));
+}
+END_TEST
+
+START_TEST(test_parse_position_piece_outside) {
+  static const char *pieces[] = {"2:0:5:1", "2:18:5:1", "2:5:9:0",
+                                 "1:18:1:0"};
+  Position_t position;
+  char text[POSITION_TEXT];
+  int board = (int)(strstr(sample, "3:4:5:1") - sample);
+
+  for (int i = 0; i < 4; i++) {
+    sprintf(text, "%.*s%s 6 1200 3 120", board, sample, pieces[i]);
+    ck_assert_ptr_null(parse_position(text, &position));
+  }
+  sprintf(text, "%.*s2:1:5:1 6 1200 3 120", board, sample);
+  ck_assert_ptr_nonnull(parse_position(text, &position));
+
+  uint8_t data[POSITION_SIZE];
+  encode_position(&position, data);
+  data[FIELD_ROWS * FIELD_COLS / 2 + 1] = 0;
+  ck_assert(!decode_position(data, &position));
+}
+END_TEST
+
+START_TEST(test_format_position_round_trip) {
+  Position_t position, copy;
+  char text[POSITION_TEXT];
+
+  parse_position(sample, &position);
+  int length = format_position(&position, text);
+  ck_assert_int_eq(length, (int)strlen(sample));
+  ck_assert_str_eq(text, sample);
+  ck_assert_ptr_nonnull(parse_position(text, &copy));
+  ck_assert_mem_eq(&copy, &position, sizeof(position));
+}
+END_TEST
+
+START_TEST(test_format_position_empty) {
+  Position_t position, copy;
+  char text[POSITION_TEXT];
+
+  memset(&position, 0, sizeof(position));
+  position.cur = (Piece_t){1, {SPAWN_ROW, SPAWN_COL}, 0};
+  position.next = 2;
+  position.level = 1;
+  format_position(&position, text);
+  ck_assert_ptr_nonnull(strstr(text, " - 1:0:5:0 2 0 1 0"));
+  ck_assert_ptr_nonnull(parse_position(text, &copy));
+  ck_assert_mem_eq(&copy, &position, sizeof(position));
+}
+END_TEST
+
+START_TEST(test_encode_position_round_trip) {
+  Position_t position, copy;
+  uint8_t data[POSITION_SIZE];
+
+  parse_position(sample, &position);
+  encode_position(&position, data);
+  ck_assert(decode_position(data, &copy));
+  ck_assert_mem_eq(&copy, &position, sizeof(position));
+  data[FIELD_ROWS * FIELD_COLS / 2] = 9;
+  ck_assert(!decode_position(data, &copy));
+}
+END_TEST
+
+START_TEST(test_load_positions) {
+  Position_t *positions = NULL;
+  FILE *file = fopen("test_positions.txt", "w");
+  fprintf(file, "%s\n\n%s\n", sample, sample);
+  fclose(file);
+  ck_assert_int_eq(load_positions("test_positions.txt", &positions), 2);
+  ck_assert_int_eq(positions[1].score, 1200);
+  free(positions);
+
+  uint8_t data[2 * POSITION_SIZE];
+  Position_t position;
+  parse_position(sample, &position);
+  position.cells[0][0] = position.cells[0][1] = 3;
+  encode_position(&position, data);
+  ck_assert_int_eq(data[0], '3');
+  position.score = 40;
+  encode_position(&position, data + POSITION_SIZE);
+  file = fopen("test_positions.txt", "wb");
+  fputs(POSITION_MAGIC, file);
+  fwrite(data, 1, sizeof(data), file);
+  fclose(file);
+  ck_assert_int_eq(load_positions("test_positions.txt", &positions), 2);
+  ck_assert_int_eq(positions[0].cells[0][1], 3);
+  ck_assert_int_eq(positions[1].score, 40);
+  free(positions);
+
+  file = fopen("test_positions.txt", "wb");
+  fputs(POSITION_MAGIC, file);
+  fwrite(data, 1, sizeof(data) - 1, file);
+  fclose(file);
+  ck_assert_int_eq(load_positions("test_positions.txt", &positions), -1);
+
+  file = fopen("test_positions.txt", "w");
+  fprintf(file, "%s\nbroken\n", sample);
+  fclose(file);
+  ck_assert_int_eq(load_positions("test_positions.txt", &positions), -1);
+  ck_assert_ptr_null(positions);
+  remove("test_positions.txt");
+  ck_assert_int_eq(load_positions("test_positions.txt", &positions), -1);
+}
+END_TEST
+
+START_TEST(test_restore_position_clear) {
+  ExpandedGameInfo_t *info = get_instance();
+  Position_t position, copy;
+
+  parse_position(sample, &position);
+  restore_position(info, &position);
+  ck_assert_int_eq(info->next_piece.type, 6);
+  ck_assert_int_eq(info->info.speed, 3);
+  capture_position(info, &copy);
+  ck_assert_mem_eq(&copy, &position, sizeof(position));
+  remove_piece(&info->info, info->cur_piece);
+  clear_full_rows(info);
+  ck_assert_int_eq(info->info.field[19][9], 0);
+  ck_assert_int_eq(info->info.field[19][2], 0);
+  ck_assert_int_eq(info->info.field[19][0], 1);
+  ck_assert_int_eq(info->info.field[19][1], 2);
+}
+END_TEST
+
+Suite *suite_notation() {
+  Suite *s = suite_create("NOTATION");
+  TCase *tc = tcase_create("notation_tc");
+
+  // parse_position
+  tcase_add_test(tc, test_parse_position_basic);
+  tcase_add_test(tc, test_parse_position_invalid);
+  tcase_add_test(tc, test_parse_position_piece_outside);
+
+  // format_position
+  tcase_add_test(tc, test_format_position_round_trip);
+  tcase_add_test(tc, test_format_position_empty);
+
+  // encode_position
+  tcase_add_test(tc, test_encode_position_round_trip);
+
+  // load_positions
+  tcase_add_test(tc, test_load_positions);
+
+  // restore_position
+  tcase_add_test(tc, test_restore_position_clear);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,118 @@
+#include "../brick_game/tetris/bot.h"
+#include "../brick_game/tetris/packed.h"
+#include "../brick_game/tetris/pool.h"
+#include "../brick_game/tetris/replay.h"
+#include "../brick_game/tetris/save.h"
+#include "tetris_test.h"
+
+#define TEST_PACKED_PIECES 30
+
+static void assert_same_game(const ExpandedGameInfo_t *a,
+                             const ExpandedGameInfo_t *b) {
+  static Save_t first, second;
+  save_game(a, &first);
+  save_game(b, &second);
+  ck_assert_mem_eq(&first, &second, sizeof(Save_t));
+}
+
+START_TEST(test_save_game_packed) {
+  GamePool_t pool;
+  Save_t save;
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  ck_assert(create_pool(&pool, 1, false));
+  create_seeded_game(&info, 23);
+  process_action(&info, Start);
+  for (int i = 0; i < TEST_PACKED_PIECES; i++) play_bot_piece(&info);
+  advance_ticks(&info, 4);
+  ck_assert_int_gt(info.lines, 0);
+
+  save_game(&info, &save);
+  ExpandedGameInfo_t *copy = acquire_game(&pool, 0);
+  ck_assert(restore_game(copy, &save));
+  assert_same_game(&info, copy);
+  for (int i = 0; i < 5; i++) {
+    play_bot_piece(&info);
+    play_bot_piece(copy);
+  }
+  assert_same_game(&info, copy);
+
+  ck_assert_uint_eq(sizeof(PackedBoard_t), 120);
+  ck_assert(sizeof(Save_t) < sizeof(GameStorage_t) / 4);
+  release_game(&pool, copy);
+  destroy_pool(&pool);
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_pack_board_basic) {
+  Board_t board, copy;
+  PackedBoard_t packed;
+  init_board(&board, NULL);
+  init_board(&copy, NULL);
+  uint64_t rng = 99;
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      board.cells[i][j] = (int)(next_random(&rng) % (PIECE_COUNT + 1));
+    }
+  }
+  pack_board(&board.info, &packed);
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    uint16_t occupied = 0;
+    for (int j = 0; j < FIELD_COLS; j++) {
+      ck_assert_int_eq(get_packed_cell(&packed, i, j), board.cells[i][j]);
+      if (board.cells[i][j]) occupied |= (uint16_t)(1u << j);
+    }
+    ck_assert_uint_eq(packed.occupied[i], occupied);
+  }
+  unpack_board(&packed, &copy.info);
+  ck_assert_mem_eq(copy.cells, board.cells, sizeof(board.cells));
+
+  set_packed_cell(&packed, 0, 9, 7);
+  ck_assert_int_eq(get_packed_cell(&packed, 0, 9), 7);
+  ck_assert(packed.occupied[0] >> 9 & 1);
+  set_packed_cell(&packed, 0, 9, 0);
+  ck_assert_int_eq(get_packed_cell(&packed, 0, 9), 0);
+  ck_assert(!(packed.occupied[0] >> 9 & 1));
+}
+END_TEST
+
+START_TEST(test_get_game_memory_basic) {
+  static Rewind_t rewind;
+  GamePool_t pool;
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 1);
+  size_t size = sizeof(ExpandedGameInfo_t) + sizeof(GameStorage_t);
+  ck_assert_uint_eq(get_game_memory(&info), size);
+  info.rewind = &rewind;
+  size += sizeof(Rewind_t);
+  ck_assert_uint_eq(get_game_memory(&info), size);
+  info.rewind = NULL;
+  exit_game(&info);
+  ck_assert_uint_eq(get_game_memory(&info), sizeof(ExpandedGameInfo_t));
+
+  ck_assert(create_pool(&pool, 1, false));
+  ExpandedGameInfo_t *game = acquire_game(&pool, 1);
+  ck_assert_uint_eq(get_game_memory(game), sizeof(PoolSlot_t));
+  release_game(&pool, game);
+  destroy_pool(&pool);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+Suite *suite_packed() {
+  Suite *s = suite_create("PACKED");
+  TCase *tc = tcase_create("packed_tc");
+
+  // save_game
+  tcase_add_test(tc, test_save_game_packed);
+  // pack_board
+  tcase_add_test(tc, test_pack_board_basic);
+  // get_game_memory
+  tcase_add_test(tc, test_get_game_memory_basic);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
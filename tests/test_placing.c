@@ -1,5 +1,13 @@
+#include "../brick_game/tetris/notation.h"
 #include "tetris_test.h"
 
+static const char *placed_position =
+    "0000000000000000300301e0000000000000000000000000000000000000 "
+    "11112222 3:0:5:0 4 0 1 0";
+static const char *removed_position =
+    "0000000000000000000001e0000000000000000000000000000000000000 "
+    "2222 3:0:5:0 4 0 1 0";
+
 START_TEST(test_place_piece) {
   GameInfo_t info;
   info.field = calloc(FIELD_ROWS, sizeof(int *));
@@ -26,37 +34,23 @@ START_TEST(test_place_piece) {
 END_TEST
 
 START_TEST(test_place_piece_multiple_times) {
-  GameInfo_t info;
-  info.field = calloc(FIELD_ROWS, sizeof(int *));
-  for (int i = 0; i < FIELD_ROWS; i++) {
-    info.field[i] = calloc(FIELD_COLS, sizeof(int));
-  }
+  ExpandedGameInfo_t info;
+  Position_t expected, position;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 1);
+  ck_assert_ptr_nonnull(parse_position(placed_position, &expected));
 
   Piece_t piece1 = {.type = 1, .pos = 0, .coords = {5, 5}};
 
   Piece_t piece2 = {.type = 2, .pos = 0, .coords = {7, 7}};
 
-  place_piece(&info, piece1);
-  place_piece(&info, piece2);
-
-  for (int i = 0; i < PIECE_SIZE; i++) {
-    Coordinate_t shift = get_piece_shifts(piece1.type, piece1.pos, i);
-    int row = piece1.coords.row + shift.row;
-    int col = piece1.coords.col + shift.col;
-    ck_assert_int_eq(info.field[row][col], piece1.type);
-  }
-
-  for (int i = 0; i < PIECE_SIZE; i++) {
-    Coordinate_t shift = get_piece_shifts(piece2.type, piece2.pos, i);
-    int row = piece2.coords.row + shift.row;
-    int col = piece2.coords.col + shift.col;
-    ck_assert_int_eq(info.field[row][col], piece2.type);
-  }
+  place_piece(&info.info, piece1);
+  place_piece(&info.info, piece2);
 
-  for (int i = 0; i < FIELD_ROWS; i++) {
-    free(info.field[i]);
-  }
-  free(info.field);
+  capture_position(&info, &position);
+  ck_assert_mem_eq(position.cells, expected.cells, sizeof(expected.cells));
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
 }
 END_TEST
 
@@ -88,39 +82,22 @@ START_TEST(test_remove_piece) {
 END_TEST
 
 START_TEST(test_remove_piece_multiple_times) {
-  GameInfo_t info;
-  info.field = calloc(FIELD_ROWS, sizeof(int *));
-  for (int i = 0; i < FIELD_ROWS; i++) {
-    info.field[i] = calloc(FIELD_COLS, sizeof(int));
-  }
+  ExpandedGameInfo_t info;
+  Position_t placed, expected, position;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 1);
+  ck_assert_ptr_nonnull(parse_position(placed_position, &placed));
+  ck_assert_ptr_nonnull(parse_position(removed_position, &expected));
+  restore_position(&info, &placed);
 
   Piece_t piece1 = {.type = 1, .pos = 0, .coords = {5, 5}};
 
-  Piece_t piece2 = {.type = 2, .pos = 0, .coords = {7, 7}};
-
-  place_piece(&info, piece1);
-  place_piece(&info, piece2);
+  remove_piece(&info.info, piece1);
 
-  remove_piece(&info, piece1);
-
-  for (int i = 0; i < PIECE_SIZE; i++) {
-    Coordinate_t shift = get_piece_shifts(piece1.type, piece1.pos, i);
-    int row = piece1.coords.row + shift.row;
-    int col = piece1.coords.col + shift.col;
-    ck_assert_int_eq(info.field[row][col], 0);
-  }
-
-  for (int i = 0; i < PIECE_SIZE; i++) {
-    Coordinate_t shift = get_piece_shifts(piece2.type, piece2.pos, i);
-    int row = piece2.coords.row + shift.row;
-    int col = piece2.coords.col + shift.col;
-    ck_assert_int_eq(info.field[row][col], piece2.type);
-  }
-
-  for (int i = 0; i < FIELD_ROWS; i++) {
-    free(info.field[i]);
-  }
-  free(info.field);
+  capture_position(&info, &position);
+  ck_assert_mem_eq(position.cells, expected.cells, sizeof(expected.cells));
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
 }
 END_TEST
 
@@ -0,0 +1,80 @@
+#include "../brick_game/tetris/pool.h"
+#include "tetris_test.h"
+
+#define TEST_POOL_GAMES 3
+
+START_TEST(test_acquire_game_basic) {
+  GamePool_t pool;
+  ExpandedGameInfo_t *games[TEST_POOL_GAMES];
+  set_high_score_file(NULL);
+  ck_assert(create_pool(&pool, TEST_POOL_GAMES, false));
+  for (int i = 0; i < TEST_POOL_GAMES; i++) {
+    games[i] = acquire_game(&pool, (uint64_t)i);
+    ck_assert_ptr_nonnull(games[i]);
+    ck_assert_ptr_eq(games[i]->info.field, games[i]->storage->rows);
+    ck_assert(games[i]->storage->pooled);
+    ck_assert_int_eq(games[i]->state, Begin);
+  }
+  ck_assert_ptr_ne(games[0], games[1]);
+  ck_assert_ptr_null(acquire_game(&pool, 7));
+  ck_assert_int_eq(pool.used, TEST_POOL_GAMES);
+
+  ExpandedGameInfo_t *game = games[1];
+  process_action(game, Start);
+  process_action(game, Up);
+  skip_ticks(game, 1000);
+  process_input(game, -1, false);
+  process_action(game, Terminate);
+  ck_assert_ptr_null(game->info.field);
+  release_game(&pool, game);
+  ck_assert_int_eq(pool.used, TEST_POOL_GAMES - 1);
+
+  game = acquire_game(&pool, 7);
+  ck_assert_ptr_eq(game, games[1]);
+  ck_assert_uint_eq(game->seed, 7);
+  ck_assert_int_eq(game->info.score, INIT_SCORE);
+  for (int i = 0; i < FIELD_ROWS; i++) {
+    for (int j = 0; j < FIELD_COLS; j++) {
+      ck_assert_int_eq(game->info.field[i][j], 0);
+    }
+  }
+  for (int i = 0; i < TEST_POOL_GAMES; i++) release_game(&pool, games[i]);
+  ck_assert_int_eq(pool.used, 0);
+  destroy_pool(&pool);
+  ck_assert_ptr_null(pool.slots);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_create_pool_huge) {
+  GamePool_t pool;
+  ck_assert(create_pool(&pool, TEST_POOL_GAMES, true));
+  ck_assert_uint_eq(pool.size % POOL_HUGE_PAGE, 0);
+  ck_assert(pool.size >= TEST_POOL_GAMES * sizeof(PoolSlot_t));
+  ck_assert_ptr_nonnull(acquire_game(&pool, 1));
+  destroy_pool(&pool);
+
+  size_t size = 4000000 * sizeof(PoolSlot_t);
+  ck_assert(get_pool_size(4000000, true) >= size);
+  ck_assert(get_pool_size(4000000, true) - size < POOL_HUGE_PAGE);
+  ck_assert_uint_eq(get_pool_size(4000000, false), size);
+  ck_assert_uint_eq(get_pool_size(-1, false), 0);
+
+  ck_assert(!create_pool(&pool, 0, false));
+  ck_assert_ptr_null(pool.slots);
+  ck_assert_ptr_null(acquire_game(&pool, 1));
+}
+END_TEST
+
+Suite *suite_pool() {
+  Suite *s = suite_create("POOL");
+  TCase *tc = tcase_create("pool_tc");
+
+  // acquire_game
+  tcase_add_test(tc, test_acquire_game_basic);
+  // create_pool
+  tcase_add_test(tc, test_create_pool_huge);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,173 @@
+#include "../brick_game/tetris/protocol.h"
+#include "tetris_test.h"
+
+START_TEST(test_parse_reply_place) {
+  Reply_t reply;
+
+  ck_assert(parse_reply("3 place 1 7\n", &reply));
+  ck_assert_int_eq(reply.id, 3);
+  ck_assert_int_eq(reply.kind, Place_reply);
+  ck_assert_int_eq(reply.pos, 1);
+  ck_assert_int_eq(reply.col, 7);
+  ck_assert(!parse_reply("3 place 4 7\n", &reply));
+  ck_assert(!parse_reply("3 place\n", &reply));
+}
+END_TEST
+
+START_TEST(test_parse_reply_keys) {
+  Reply_t reply;
+
+  ck_assert(parse_reply("12 keys LLAU\n", &reply));
+  ck_assert_int_eq(reply.id, 12);
+  ck_assert_int_eq(reply.kind, Keys_reply);
+  ck_assert_int_eq(reply.keys.length, 4);
+  ck_assert_int_eq(reply.keys.keys[0], Left);
+  ck_assert_int_eq(reply.keys.keys[2], Action);
+  ck_assert_int_eq(reply.keys.keys[3], Up);
+  ck_assert(!parse_reply("12 keys LXR\n", &reply));
+}
+END_TEST
+
+START_TEST(test_parse_reply_other) {
+  Reply_t reply;
+
+  ck_assert(parse_reply("1 quit\n", &reply));
+  ck_assert_int_eq(reply.kind, Quit_reply);
+  ck_assert(!parse_reply("1 jump\n", &reply));
+  ck_assert(!parse_reply("ready\n", &reply));
+}
+END_TEST
+
+START_TEST(test_apply_reply_place) {
+  ExpandedGameInfo_t info;
+  start_protocol_game(&info);
+  clear_field(&info.info);
+  info.cur_piece = (Piece_t){2, {SPAWN_ROW, SPAWN_COL}, 0};
+  info.next_piece = (Piece_t){1, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info.info, info.cur_piece);
+  Reply_t reply;
+  parse_reply("1 place 1 0\n", &reply);
+
+  ck_assert(apply_reply(&info, &reply));
+  for (int i = 16; i < FIELD_ROWS; i++) {
+    ck_assert_int_eq(info.info.field[i][0], 2);
+  }
+  ck_assert_int_eq(info.cur_piece.type, 1);
+  ck_assert_int_eq(info.state, Play);
+
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_apply_reply_keys_clear) {
+  ExpandedGameInfo_t info;
+  start_protocol_game(&info);
+  clear_field(&info.info);
+  for (int j = 0; j < FIELD_COLS - 4; j++) {
+    info.info.field[19][j] = 1;
+  }
+  info.cur_piece = (Piece_t){2, {SPAWN_ROW, SPAWN_COL}, 0};
+  info.next_piece = (Piece_t){1, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info.info, info.cur_piece);
+  info.info.score = 0;
+  Reply_t reply;
+  parse_reply("1 keys RRR\n", &reply);
+
+  ck_assert(apply_reply(&info, &reply));
+  ck_assert_int_eq(info.info.score, get_points(1));
+  for (int j = 0; j < FIELD_COLS; j++) {
+    ck_assert_int_eq(info.info.field[19][j], 0);
+  }
+
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_write_position_basic) {
+  ExpandedGameInfo_t info;
+  start_protocol_game(&info);
+  info.info.field[19][0] = 3;
+  info.info.field[19][9] = 3;
+  info.cur_piece = (Piece_t){4, {SPAWN_ROW, SPAWN_COL}, 0};
+  info.next_piece = (Piece_t){5, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info.info, info.cur_piece);
+  char text[PROTOCOL_LINE] = "";
+  FILE *out = tmpfile();
+
+  write_position(out, 2, &info);
+  rewind(out);
+  fgets(text, sizeof(text), out);
+  fclose(out);
+
+  ck_assert_int_eq(strncmp(text, "position 2 000000", 17), 0);
+  ck_assert_ptr_nonnull(strstr(text, "201 4 5 1 0\n"));
+  ck_assert(is_piece_on_field(&info.info, info.cur_piece));
+
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_run_protocol_quit) {
+  char text[PROTOCOL_LINE] = "";
+  FILE *in = tmpfile();
+  FILE *out = tmpfile();
+  fprintf(in, "ready\n9 quit\n2 quit\n2 keys U\nnonsense\n1 quit\n");
+  rewind(in);
+
+  ck_assert_int_eq(run_protocol(in, out, 2), 0);
+
+  rewind(out);
+  int positions = 0, gameovers = 0;
+  char errors[3 * PROTOCOL_LINE] = "";
+  while (fgets(text, sizeof(text), out) != NULL) {
+    if (strncmp(text, "position", 8) == 0) positions++;
+    if (strncmp(text, "gameover", 8) == 0) gameovers++;
+    if (strncmp(text, "error", 5) == 0) strcat(errors, text);
+  }
+  ck_assert_int_eq(positions, 2);
+  ck_assert_int_eq(gameovers, 2);
+  ck_assert_str_eq(errors, "error 9\nerror 2\nerror 0\n");
+  ck_assert_str_eq(text, "bye\n");
+
+  fclose(in);
+  fclose(out);
+}
+END_TEST
+
+START_TEST(test_run_protocol_no_reply) {
+  FILE *in = tmpfile();
+  FILE *out = tmpfile();
+  fprintf(in, "ready\n");
+  rewind(in);
+
+  ck_assert_int_eq(run_protocol(in, out, 1), -1);
+  ck_assert_int_eq(run_protocol(in, out, 0), -1);
+
+  fclose(in);
+  fclose(out);
+}
+END_TEST
+
+Suite *suite_protocol() {
+  Suite *s = suite_create("PROTOCOL");
+  TCase *tc = tcase_create("protocol_tc");
+
+  // parse_reply
+  tcase_add_test(tc, test_parse_reply_place);
+  tcase_add_test(tc, test_parse_reply_keys);
+  tcase_add_test(tc, test_parse_reply_other);
+
+  // apply_reply
+  tcase_add_test(tc, test_apply_reply_place);
+  tcase_add_test(tc, test_apply_reply_keys_clear);
+
+  // write_position
+  tcase_add_test(tc, test_write_position_basic);
+
+  // run_protocol
+  tcase_add_test(tc, test_run_protocol_quit);
+  tcase_add_test(tc, test_run_protocol_no_reply);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -56,6 +56,47 @@ START_TEST(test_save_high_score_basic) {
 }
 END_TEST
 
+START_TEST(test_write_high_score_basic) {
+  const char *path = "test_high_score.txt";
+  ck_assert(write_high_score(path, 4200));
+  FILE *file = fopen(path, "r");
+  ck_assert_ptr_nonnull(file);
+  int saved_high_score = 0;
+  fscanf(file, "%d", &saved_high_score);
+  fclose(file);
+  ck_assert_int_eq(saved_high_score, 4200);
+  ck_assert_ptr_null(fopen("test_high_score.txt.tmp", "r"));
+  ck_assert(!write_high_score("missing_dir/high_score.txt", 1));
+  remove(path);
+}
+END_TEST
+
+START_TEST(test_high_score_writer_coalesced) {
+  const char *path = "test_high_score.txt";
+  remove(path);
+  set_high_score_file(path);
+  ck_assert(start_high_score_writer());
+  ck_assert(start_high_score_writer());
+  for (int i = 1; i <= 1000; i++) {
+    GameInfo_t info = {NULL, NULL, 0, i * 100, 1, 1, 0};
+    save_high_score(&info);
+  }
+  GameInfo_t lower = {NULL, NULL, 0, 500, 1, 1, 0};
+  save_high_score(&lower);
+  int writes = stop_high_score_writer();
+  ck_assert_int_ge(writes, 1);
+  ck_assert_int_lt(writes, 10);
+  ck_assert_int_eq(load_high_score(), 100000);
+  ck_assert_int_eq(stop_high_score_writer(), writes);
+
+  GameInfo_t info = {NULL, NULL, 0, 7, 1, 1, 0};
+  save_high_score(&info);
+  ck_assert_int_eq(load_high_score(), 7);
+  set_high_score_file(FILE_PATH);
+  remove(path);
+}
+END_TEST
+
 Suite *suite_recording() {
   Suite *s = suite_create("RECORDING");
   TCase *tc = tcase_create("recording_tc");
@@ -66,6 +107,12 @@ Suite *suite_recording() {
   // save_high_score
   tcase_add_test(tc, test_save_high_score_basic);
 
+  // write_high_score
+  tcase_add_test(tc, test_write_high_score_basic);
+
+  // start_high_score_writer
+  tcase_add_test(tc, test_high_score_writer_coalesced);
+
   suite_add_tcase(s, tc);
   return s;
 }
@@ -0,0 +1,235 @@
+#include "../brick_game/tetris/bot.h"
+#include "../brick_game/tetris/finesse.h"
+#include "../brick_game/tetris/replay.h"
+#include "tetris_test.h"
+
+#define TEST_REPLAY_PATH "test_replay.bin"
+
+START_TEST(test_put_varint_basic) {
+  const uint64_t values[] = {0, 1, 127, 128, 300, 1ULL << 35, UINT64_MAX};
+  const size_t sizes[] = {1, 1, 1, 2, 2, 6, 10};
+  unsigned char buffer[VARINT_MAX * 7];
+  size_t length = 0;
+  for (int i = 0; i < 7; i++) {
+    size_t size = put_varint(buffer + length, values[i]);
+    ck_assert_uint_eq(size, sizes[i]);
+    length += size;
+  }
+  size_t offset = 0;
+  for (int i = 0; i < 7; i++) {
+    uint64_t value;
+    ck_assert(get_varint(buffer, length, &offset, &value));
+    ck_assert_uint_eq(value, values[i]);
+  }
+  ck_assert_uint_eq(offset, length);
+  uint64_t value;
+  ck_assert(!get_varint(buffer, 1, &offset, &value));
+  offset = 0;
+  ck_assert(!get_varint(buffer + 3, 1, &offset, &value));
+}
+END_TEST
+
+START_TEST(test_draw_piece_seeded) {
+  uint64_t first = 77, second = 77;
+  srand(1);
+  int expected = rand();
+  srand(1);
+  for (int i = 0; i < 100; i++) {
+    Piece_t piece = draw_piece(&first);
+    ck_assert_int_eq(piece.type, draw_piece(&second).type);
+    ck_assert(piece.type >= 1 && piece.type <= PIECE_COUNT);
+    ck_assert_int_eq(piece.coords.row, SPAWN_ROW);
+    ck_assert_int_eq(piece.coords.col, SPAWN_COL);
+    ck_assert_int_eq(piece.pos, 0);
+  }
+  ck_assert_int_eq(rand(), expected);
+
+  ExpandedGameInfo_t a, b;
+  create_seeded_game(&a, 5);
+  create_seeded_game(&b, 5);
+  ck_assert_int_eq(a.cur_piece.type, b.cur_piece.type);
+  ck_assert_int_eq(a.next_piece.type, b.next_piece.type);
+  ck_assert_uint_eq(a.seed, 5);
+  exit_game(&a);
+  exit_game(&b);
+}
+END_TEST
+
+START_TEST(test_record_action_events) {
+  Recorder_t recorder;
+  ExpandedGameInfo_t info = {.info = {.score = 1200, .level = 3}, .lines = 9};
+  ck_assert(open_recorder(&recorder, TEST_REPLAY_PATH, 99));
+  record_action(&recorder, Start);
+  record_ticks(&recorder, 40);
+  record_action(&recorder, Left);
+  record_action(&recorder, -1);
+  record_ticks(&recorder, 2);
+  record_ticks(&recorder, 1);
+  record_action(&recorder, Action);
+  record_ticks(&recorder, 5);
+  ck_assert(close_recorder(&recorder, &info));
+
+  Replay_t replay;
+  uint64_t ticks;
+  UserAction_t action;
+  ck_assert(load_replay(&replay, TEST_REPLAY_PATH));
+  ck_assert_uint_eq(replay.header.seed, 99);
+  ck_assert_uint_eq(replay.size, 1 + 2 + 1 + 1 + 2 + 1 + 1 + 1);
+  const uint64_t expected_ticks[] = {0, 40, 3, 5};
+  const UserAction_t expected_actions[] = {Start, Left, Action, Terminate};
+  for (int i = 0; i < 4; i++) {
+    ck_assert(next_replay_event(&replay, &ticks, &action));
+    ck_assert_uint_eq(ticks, expected_ticks[i]);
+    ck_assert_int_eq(action, expected_actions[i]);
+  }
+  ck_assert(!next_replay_event(&replay, &ticks, &action));
+  ck_assert(replay.complete);
+  ck_assert_int_eq(replay.summary.score, 1200);
+  ck_assert_int_eq(replay.summary.level, 3);
+  ck_assert_int_eq(replay.summary.lines, 9);
+  ck_assert_uint_eq(replay.summary.ticks, 48);
+  free_replay(&replay);
+  remove(TEST_REPLAY_PATH);
+}
+END_TEST
+
+START_TEST(test_run_replay_reproduces) {
+  ExpandedGameInfo_t live, played;
+  Recorder_t recorder;
+  create_seeded_game(&live, 2024);
+  ck_assert(open_recorder(&recorder, TEST_REPLAY_PATH, live.seed));
+  record_action(&recorder, Start);
+  process_action(&live, Start);
+  for (int i = 0; i < 40 && live.state != Game_over; i++) {
+    Piece_t target;
+    Path_t path = {.length = 0};
+    if (choose_placement(&live, NULL, NULL, &target))
+      find_path(&live, target, &path);
+    for (int k = 0; k < path.length; k++) {
+      record_action(&recorder, path.keys[k]);
+      process_action(&live, path.keys[k]);
+    }
+    record_action(&recorder, Up);
+    process_action(&live, Up);
+    record_ticks(&recorder, skip_ticks(&live, 1000) + 1);
+    process_input(&live, -1, false);
+  }
+  ck_assert(close_recorder(&recorder, &live));
+  ck_assert_int_gt(live.lines, 0);
+
+  Replay_t replay;
+  ReplaySummary_t result;
+  ck_assert(load_replay(&replay, TEST_REPLAY_PATH));
+  ck_assert(run_replay(&replay, &played, &result));
+  ck_assert_int_eq(result.score, replay.summary.score);
+  ck_assert_int_eq(result.level, replay.summary.level);
+  ck_assert_int_eq(result.lines, replay.summary.lines);
+  ck_assert_uint_eq(result.ticks, replay.summary.ticks);
+  ck_assert_int_eq(result.score, live.info.score);
+  ck_assert_int_eq(result.lines, live.lines);
+  free_replay(&replay);
+  exit_game(&live);
+  remove(TEST_REPLAY_PATH);
+}
+END_TEST
+
+START_TEST(test_run_replay_incomplete) {
+  Recorder_t recorder;
+  ck_assert(open_recorder(&recorder, TEST_REPLAY_PATH, 3));
+  record_action(&recorder, Start);
+  record_ticks(&recorder, 30);
+  record_action(&recorder, Down);
+  flush_recorder(&recorder);
+  close(recorder.fd);
+
+  Replay_t replay;
+  ExpandedGameInfo_t played;
+  ReplaySummary_t result;
+  ck_assert(load_replay(&replay, TEST_REPLAY_PATH));
+  ck_assert(!run_replay(&replay, &played, &result));
+  ck_assert_uint_eq(result.ticks, 30);
+  free_replay(&replay);
+  remove(TEST_REPLAY_PATH);
+}
+END_TEST
+
+START_TEST(test_verify_replay_basic) {
+  ExpandedGameInfo_t live;
+  Recorder_t recorder;
+  ReplaySummary_t expected, result;
+  set_high_score_file(NULL);
+  create_seeded_game(&live, 8);
+  ck_assert(open_recorder(&recorder, TEST_REPLAY_PATH, live.seed));
+  record_action(&recorder, Start);
+  process_action(&live, Start);
+  record_ticks(&recorder, 25);
+  advance_ticks(&live, 25);
+  record_action(&recorder, Up);
+  process_action(&live, Up);
+  ck_assert(close_recorder(&recorder, &live));
+  ck_assert_int_eq(verify_replay(TEST_REPLAY_PATH, &expected, &result),
+                   Replay_valid);
+  ck_assert_int_eq(result.score, live.info.score);
+  ck_assert_uint_eq(result.ticks, 25);
+
+  live.info.score += 100;
+  ck_assert(open_recorder(&recorder, TEST_REPLAY_PATH, live.seed));
+  record_action(&recorder, Start);
+  record_ticks(&recorder, 25);
+  record_action(&recorder, Up);
+  ck_assert(close_recorder(&recorder, &live));
+  ck_assert_int_eq(verify_replay(TEST_REPLAY_PATH, &expected, &result),
+                   Replay_mismatch);
+  ck_assert_int_eq(expected.score, result.score + 100);
+  exit_game(&live);
+
+  ck_assert(open_recorder(&recorder, TEST_REPLAY_PATH, 8));
+  record_ticks(&recorder, 10);
+  record_action(&recorder, Start);
+  flush_recorder(&recorder);
+  close(recorder.fd);
+  ck_assert_int_eq(verify_replay(TEST_REPLAY_PATH, &expected, &result),
+                   Replay_incomplete);
+  remove(TEST_REPLAY_PATH);
+  ck_assert_int_eq(verify_replay(TEST_REPLAY_PATH, &expected, &result),
+                   Replay_unreadable);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_load_replay_invalid) {
+  Replay_t replay;
+  remove(TEST_REPLAY_PATH);
+  ck_assert(!load_replay(&replay, TEST_REPLAY_PATH));
+
+  FILE *file = fopen(TEST_REPLAY_PATH, "wb");
+  ck_assert_ptr_nonnull(file);
+  fprintf(file, "TTRSBOOK and some more bytes than a header has.");
+  fclose(file);
+  ck_assert(!load_replay(&replay, TEST_REPLAY_PATH));
+  ck_assert_ptr_null(replay.data);
+  remove(TEST_REPLAY_PATH);
+}
+END_TEST
+
+Suite *suite_replay() {
+  Suite *s = suite_create("REPLAY");
+  TCase *tc = tcase_create("replay_tc");
+
+  // put_varint
+  tcase_add_test(tc, test_put_varint_basic);
+  // draw_piece
+  tcase_add_test(tc, test_draw_piece_seeded);
+  // record_action
+  tcase_add_test(tc, test_record_action_events);
+  // run_replay
+  tcase_add_test(tc, test_run_replay_reproduces);
+  tcase_add_test(tc, test_run_replay_incomplete);
+  // verify_replay
+  tcase_add_test(tc, test_verify_replay_basic);
+  // load_replay
+  tcase_add_test(tc, test_load_replay_invalid);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -0,0 +1,123 @@
+#include "../brick_game/tetris/replay.h"
+#include "../brick_game/tetris/rewind.h"
+#include "../brick_game/tetris/save.h"
+#include "tetris_test.h"
+
+#define TEST_REWIND_PIECES 40
+
+START_TEST(test_rewind_game_basic) {
+  static Rewind_t rewind;
+  static Save_t spawns[TEST_REWIND_PIECES + 1];
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 41);
+  clear_rewind(&rewind);
+  info.rewind = &rewind;
+  process_action(&info, Start);
+  int pieces = 0;
+  while (pieces < TEST_REWIND_PIECES && info.state != Game_over) {
+    play_bot_piece(&info);
+    save_game(&info, &spawns[++pieces]);
+  }
+  ck_assert_int_eq(pieces, TEST_REWIND_PIECES);
+  ck_assert_int_eq(rewind.count, pieces);
+  ck_assert_int_gt(info.lines, 0);
+
+  for (int k = pieces; k > 1; k--) {
+    ck_assert_int_eq(rewind_game(&info, 1), 1);
+    Save_t now, *expected = &spawns[k - 1];
+    save_game(&info, &now);
+    now.high_score = expected->high_score;
+    now.timer = expected->timer;
+    now.prev_state = expected->prev_state;
+    now.checksum = expected->checksum;
+    ck_assert_mem_eq(&now, expected, sizeof(Save_t));
+  }
+  ck_assert_int_eq(rewind_game(&info, REWIND_TICKS), 1);
+  ck_assert_int_eq(rewind.count, 0);
+  ck_assert_int_eq(info.info.score, INIT_SCORE);
+  ck_assert_int_eq(info.lines, 0);
+  ck_assert_int_eq(rewind_game(&info, REWIND_TICKS), 0);
+
+  play_bot_piece(&info);
+  ck_assert_int_eq(info.cur_piece.type, spawns[1].cur.type);
+  ck_assert_int_eq(info.next_piece.type, spawns[1].next);
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_rewind_game_ticks) {
+  static Rewind_t rewind;
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 8);
+  clear_rewind(&rewind);
+  info.rewind = &rewind;
+  ck_assert_int_eq(rewind_game(&info, REWIND_TICKS), -1);
+  process_action(&info, Start);
+  for (int i = 0; i < 10; i++) play_bot_piece(&info);
+  advance_ticks(&info, 5);
+  ck_assert_int_eq(rewind.ticks, 5);
+  ck_assert_int_eq(rewind_game(&info, 5), 0);
+  ck_assert_int_eq(info.cur_piece.coords.row, SPAWN_ROW);
+  ck_assert_int_eq(rewind.count, 10);
+
+  int ticks = rewind.deltas[rewind.head].ticks;
+  ck_assert_int_eq(rewind_game(&info, ticks + 1), 2);
+  ck_assert_int_eq(rewind.count, 8);
+
+  process_action(&info, Pause);
+  ck_assert_int_eq(rewind_game(&info, 1), 1);
+  info.rewind = NULL;
+  ck_assert_int_eq(rewind_game(&info, 1), -1);
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+START_TEST(test_record_lock_overflow) {
+  static Rewind_t rewind;
+  ExpandedGameInfo_t info;
+  set_high_score_file(NULL);
+  create_seeded_game(&info, 5);
+  clear_rewind(&rewind);
+  info.rewind = &rewind;
+  for (int i = 0; i < REWIND_SIZE + 10; i++) {
+    info.cur_piece.coords.row = i % FIELD_ROWS;
+    record_lock(&rewind, &info);
+  }
+  ck_assert_int_eq(rewind.count, REWIND_SIZE);
+  int last = (REWIND_SIZE + 9) % FIELD_ROWS;
+  ck_assert_int_eq(rewind.deltas[rewind.head].row, last);
+  ck_assert(rewind.locked);
+  record_rows(&rewind, &info.info);
+  ck_assert(!rewind.locked);
+  ck_assert_uint_eq(rewind.deltas[rewind.head].rows, 0);
+
+  process_action(&info, Start);
+  for (int i = 0; i < 100 && info.state != Game_over; i++) {
+    process_action(&info, Up);
+    skip_ticks(&info, 1000);
+    process_input(&info, -1, false);
+  }
+  ck_assert_int_eq(info.state, Game_over);
+  ck_assert_int_eq(rewind.count, 0);
+  exit_game(&info);
+  set_high_score_file(FILE_PATH);
+}
+END_TEST
+
+Suite *suite_rewind() {
+  Suite *s = suite_create("REWIND");
+  TCase *tc = tcase_create("rewind_tc");
+
+  // rewind_game
+  tcase_add_test(tc, test_rewind_game_basic);
+  tcase_add_test(tc, test_rewind_game_ticks);
+  // record_lock
+  tcase_add_test(tc, test_record_lock_overflow);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
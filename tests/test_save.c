@@ -0,0 +1,140 @@
+#include "../brick_game/tetris/replay.h"
+#include "../brick_game/tetris/save.h"
+#include "tetris_test.h"
+
+#define TEST_RESUME_PATH "test_resume.bin"
+
+START_TEST(test_save_game_basic) {
+  ExpandedGameInfo_t info, copy;
+  Save_t save, again;
+  create_seeded_game(&info, 17);
+  process_action(&info, Start);
+  advance_ticks(&info, 300);
+  process_action(&info, Left);
+  info.lines = 4;
+  save_game(&info, &save);
+  ck_assert_uint_eq(save.size, sizeof(Save_t));
+  ck_assert(is_valid_save(&save));
+
+  create_seeded_game(&copy, 99);
+  ck_assert(restore_game(&copy, &save));
+  save_game(&copy, &again);
+  ck_assert_mem_eq(&save, &again, sizeof(Save_t));
+  ck_assert_int_eq(copy.state, info.state);
+  ck_assert_int_eq(copy.prev_state, info.prev_state);
+  ck_assert_uint_eq(copy.seed, 17);
+  ck_assert_int_eq(copy.changes.rows, FIELD_ROWS_MASK);
+
+  advance_ticks(&info, 2000);
+  advance_ticks(&copy, 2000);
+  save_game(&info, &save);
+  save_game(&copy, &again);
+  ck_assert_mem_eq(&save, &again, sizeof(Save_t));
+  exit_game(&info);
+  exit_game(&copy);
+}
+END_TEST
+
+START_TEST(test_restore_game_invalid) {
+  ExpandedGameInfo_t info;
+  Save_t save;
+  create_seeded_game(&info, 3);
+  save_game(&info, &save);
+  info.info.score = 700;
+
+  Save_t broken = save;
+  set_packed_cell(&broken.board, 5, 5, 1);
+  ck_assert(!restore_game(&info, &broken));
+  broken = save;
+  broken.board.occupied[5] |= 1;
+  broken.checksum = get_save_checksum(&broken);
+  ck_assert(!restore_game(&info, &broken));
+  broken = save;
+  broken.board.occupied[5] |= 1u << FIELD_COLS;
+  broken.checksum = get_save_checksum(&broken);
+  ck_assert(!restore_game(&info, &broken));
+  broken = save;
+  broken.version++;
+  ck_assert(!restore_game(&info, &broken));
+  broken = save;
+  broken.next = PIECE_COUNT + 1;
+  broken.checksum = get_save_checksum(&broken);
+  ck_assert(!restore_game(&info, &broken));
+  broken = save;
+  broken.cur.coords.row = -5;
+  broken.checksum = get_save_checksum(&broken);
+  ck_assert(!restore_game(&info, &broken));
+  broken = save;
+  broken.cur = (Piece_t){2, {0, SPAWN_COL}, 1};
+  broken.checksum = get_save_checksum(&broken);
+  ck_assert(!restore_game(&info, &broken));
+  broken.cur.coords.row = 1;
+  broken.checksum = get_save_checksum(&broken);
+  ck_assert(is_valid_save(&broken));
+  ck_assert_int_eq(info.info.score, 700);
+  ck_assert(restore_game(&info, &save));
+  ck_assert_int_eq(info.info.score, INIT_SCORE);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_update_resume_basic) {
+  Resume_t resume;
+  ExpandedGameInfo_t info, resumed;
+  remove(TEST_RESUME_PATH);
+  ck_assert(open_resume(&resume, TEST_RESUME_PATH));
+  ck_assert_ptr_null(find_resume(&resume));
+
+  create_seeded_game(&info, 12);
+  process_action(&info, Start);
+  for (int i = 0; i < 50; i++) {
+    process_input(&info, -1, false);
+    update_resume(&resume, &info);
+  }
+  ck_assert_uint_eq(resume.sequence, 50);
+  close_resume(&resume, true);
+
+  ck_assert(open_resume(&resume, TEST_RESUME_PATH));
+  ck_assert_uint_eq(resume.sequence, 50);
+  ck_assert_int_eq(resume.current, 1);
+  Save_t *torn = &resume.slots[1];
+  ck_assert_uint_eq(torn->sequence, 50);
+  torn->score = 12345;
+  ck_assert_uint_eq(find_resume(&resume)->sequence, 49);
+  close_resume(&resume, true);
+
+  ck_assert(open_resume(&resume, TEST_RESUME_PATH));
+  ck_assert_int_eq(resume.current, 0);
+  update_resume(&resume, &info);
+  ck_assert_uint_eq(find_resume(&resume)->sequence, 50);
+  ck_assert_uint_eq(resume.slots[0].sequence, 49);
+
+  create_seeded_game(&resumed, 1);
+  ck_assert(restore_game(&resumed, find_resume(&resume)));
+  ck_assert_int_eq(resumed.timer, info.timer);
+  ck_assert_int_eq(resumed.cur_piece.coords.row, info.cur_piece.coords.row);
+  close_resume(&resume, false);
+
+  ck_assert(open_resume(&resume, TEST_RESUME_PATH));
+  ck_assert_ptr_null(find_resume(&resume));
+  close_resume(&resume, false);
+  exit_game(&info);
+  exit_game(&resumed);
+  remove(TEST_RESUME_PATH);
+}
+END_TEST
+
+Suite *suite_save() {
+  Suite *s = suite_create("SAVE");
+  TCase *tc = tcase_create("save_tc");
+
+  // save_game
+  tcase_add_test(tc, test_save_game_basic);
+  // restore_game
+  tcase_add_test(tc, test_restore_game_invalid);
+  // update_resume
+  tcase_add_test(tc, test_update_resume_basic);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
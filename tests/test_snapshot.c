@@ -0,0 +1,157 @@
+#include <pthread.h>
+
+#include "../brick_game/tetris/snapshot.h"
+#include "tetris_test.h"
+
+#define TEST_SNAPSHOTS 20000
+
+START_TEST(test_take_snapshot_copy) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  info.state = Play;
+  info.info.field[19][3] = 5;
+  info.info.score = 300;
+  Snapshot_t snapshot;
+
+  take_snapshot(&info, &snapshot);
+  info.info.field[19][3] = 0;
+  ck_assert_int_eq(snapshot.field[19][3], 5);
+  ck_assert_int_eq(snapshot.score, 300);
+  ck_assert_int_eq(snapshot.state, Play);
+  ck_assert_uint_eq(snapshot.changes.rows, FIELD_ROWS_MASK);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_publish_snapshot_acquire) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  SnapshotBuffer_t buffer;
+  init_snapshots(&buffer);
+
+  ck_assert_ptr_null(acquire_snapshot(&buffer));
+  info.info.score = 40;
+  publish_snapshot(&buffer, &info);
+  ck_assert(is_unchanged(get_changes(&info)));
+  Snapshot_t *snapshot = acquire_snapshot(&buffer);
+  ck_assert_ptr_nonnull(snapshot);
+  ck_assert_int_eq(snapshot->score, 40);
+  ck_assert_uint_eq(snapshot->changes.rows, FIELD_ROWS_MASK);
+  ck_assert_ptr_null(acquire_snapshot(&buffer));
+
+  info.changes.rows = 1u << 7;
+  publish_snapshot(&buffer, &info);
+  snapshot = acquire_snapshot(&buffer);
+  ck_assert_uint_eq(snapshot->changes.rows, 1u << 7);
+  ck_assert(!snapshot->changes.next);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_publish_snapshot_merged) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  reset_changes(&info);
+  SnapshotBuffer_t buffer;
+  init_snapshots(&buffer);
+
+  for (int i = 0; i < 5; i++) {
+    info.info.score = i;
+    info.changes.rows = 1u << i;
+    publish_snapshot(&buffer, &info);
+  }
+  info.changes.fields = Score_changed;
+  publish_snapshot(&buffer, &info);
+  Snapshot_t *snapshot = acquire_snapshot(&buffer);
+  ck_assert_int_eq(snapshot->score, 4);
+  ck_assert_uint_eq(snapshot->changes.rows, 0x1fu);
+  ck_assert_uint_eq(snapshot->changes.fields, Score_changed);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_snapshot_info) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  Snapshot_t snapshot;
+  take_snapshot(&info, &snapshot);
+  snapshot.field[4][2] = 7;
+  int *field[FIELD_ROWS], *next[NEXT_ROWS];
+
+  GameInfo_t view = snapshot_info(&snapshot, field, next);
+  ck_assert_int_eq(view.field[4][2], 7);
+  ck_assert_ptr_eq(view.next[1], snapshot.next[1]);
+  ck_assert_int_eq(view.level, info.info.level);
+  exit_game(&info);
+}
+END_TEST
+
+static void *read_snapshots(void *arg) {
+  SnapshotBuffer_t *buffer = arg;
+  long consistent = 1;
+  int last = -1;
+  while (last < TEST_SNAPSHOTS - 1) {
+    Snapshot_t *snapshot = acquire_snapshot(buffer);
+    if (!snapshot) continue;
+    for (int i = 0; i < FIELD_ROWS; i++) {
+      for (int j = 0; j < FIELD_COLS; j++) {
+        if (snapshot->field[i][j] != snapshot->score) consistent = 0;
+      }
+    }
+    if (snapshot->score <= last) consistent = 0;
+    last = snapshot->score;
+  }
+  return (void *)consistent;
+}
+
+START_TEST(test_snapshot_threads) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  SnapshotBuffer_t buffer;
+  init_snapshots(&buffer);
+  pthread_t reader;
+  ck_assert_int_eq(pthread_create(&reader, NULL, read_snapshots, &buffer), 0);
+
+  for (int k = 0; k < TEST_SNAPSHOTS; k++) {
+    for (int i = 0; i < FIELD_ROWS; i++) {
+      for (int j = 0; j < FIELD_COLS; j++) info.info.field[i][j] = k;
+    }
+    info.info.score = k;
+    publish_snapshot(&buffer, &info);
+  }
+  void *consistent = NULL;
+  pthread_join(reader, &consistent);
+  ck_assert(consistent);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_merge_changes) {
+  Changes_t changes = {1u << 2, Level_changed, false};
+  merge_changes(&changes, (Changes_t){1u << 9, Score_changed, true});
+  ck_assert_uint_eq(changes.rows, 1u << 2 | 1u << 9);
+  ck_assert_uint_eq(changes.fields, Level_changed | Score_changed);
+  ck_assert(changes.next);
+  ck_assert(!is_unchanged(changes));
+  ck_assert(is_unchanged((Changes_t){0, 0, false}));
+}
+END_TEST
+
+Suite *suite_snapshot() {
+  Suite *s = suite_create("SNAPSHOT");
+  TCase *tc = tcase_create("snapshot_tc");
+
+  // take_snapshot
+  tcase_add_test(tc, test_take_snapshot_copy);
+  // publish_snapshot
+  tcase_add_test(tc, test_publish_snapshot_acquire);
+  tcase_add_test(tc, test_publish_snapshot_merged);
+  tcase_add_test(tc, test_snapshot_threads);
+  // snapshot_info
+  tcase_add_test(tc, test_snapshot_info);
+  // merge_changes
+  tcase_add_test(tc, test_merge_changes);
+
+  suite_add_tcase(s, tc);
+  return s;
+}
@@ -58,7 +58,30 @@ END_TEST
 
 START_TEST(test_userInput_game_over) {
   ExpandedGameInfo_t *info = get_instance();
-  info->info.field[0][5] = 1;
+  info->state = Play;
+  info->timer = DELAY;
+  info->cur_piece = (Piece_t){4, {SPAWN_ROW, SPAWN_COL}, 0};
+  for (int j = 1; j < FIELD_COLS; j++) {
+    info->info.field[2][j] = 1;
+  }
+
+  userInput(Right, false);
+
+  ck_assert_int_eq(info->state, Game_over);
+  exit_game(info);
+}
+END_TEST
+
+START_TEST(test_userInput_game_over_same_shape) {
+  ExpandedGameInfo_t *info = get_instance();
+  info->state = Play;
+  info->timer = DELAY;
+  info->cur_piece = (Piece_t){4, {SPAWN_ROW, SPAWN_COL}, 0};
+  info->next_piece = info->cur_piece;
+  place_piece(&info->info, info->cur_piece);
+  for (int j = 1; j < FIELD_COLS; j++) {
+    info->info.field[2][j] = 1;
+  }
 
   userInput(Right, false);
 
@@ -67,6 +90,41 @@ START_TEST(test_userInput_game_over) {
 }
 END_TEST
 
+START_TEST(test_process_action_move) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  info.state = Play;
+  info.cur_piece = (Piece_t){2, {SPAWN_ROW, SPAWN_COL}, 0};
+  place_piece(&info.info, info.cur_piece);
+  int timer = info.timer;
+
+  process_action(&info, Right);
+  process_action(&info, Right);
+
+  ck_assert_int_eq(info.cur_piece.coords.col, SPAWN_COL + 2);
+  ck_assert_int_eq(info.timer, timer);
+  ck_assert_int_eq(info.state, Play);
+  ck_assert(process_input(&info, -1, false));
+  ck_assert_int_eq(info.timer, timer - DELAY);
+  exit_game(&info);
+}
+END_TEST
+
+START_TEST(test_process_action_start) {
+  ExpandedGameInfo_t info;
+  create_game(&info);
+  int timer = info.timer;
+
+  process_action(&info, Left);
+  ck_assert_int_eq(info.state, Begin);
+  process_action(&info, Start);
+
+  ck_assert_int_eq(info.state, Play);
+  ck_assert_int_eq(info.timer, timer);
+  exit_game(&info);
+}
+END_TEST
+
 START_TEST(test_updateCurrentState_basic) {
   GameInfo_t info = updateCurrentState();
 
@@ -109,6 +167,11 @@ Suite *suite_specifics() {
   tcase_add_test(tc, test_userInput_move);
   tcase_add_test(tc, test_userInput_score_up);
   tcase_add_test(tc, test_userInput_game_over);
+  tcase_add_test(tc, test_userInput_game_over_same_shape);
+
+  // process_action
+  tcase_add_test(tc, test_process_action_move);
+  tcase_add_test(tc, test_process_action_start);
 
   // updateCurrentState
   tcase_add_test(tc, test_updateCurrentState_basic);
@@ -30,6 +30,33 @@ START_TEST(test_update_timer_negative_timer) {
 }
 END_TEST
 
+START_TEST(test_get_idle_ticks_play) {
+  ExpandedGameInfo_t info = {.timer = 5 * DELAY, .state = Play};
+
+  ck_assert_int_eq(get_idle_ticks(&info), 4);
+  info.timer = 5 * DELAY + 1;
+  ck_assert_int_eq(get_idle_ticks(&info), 5);
+  info.timer = DELAY;
+  ck_assert_int_eq(get_idle_ticks(&info), 0);
+  info.state = Stop;
+  info.timer = 5 * DELAY;
+  ck_assert_int_eq(get_idle_ticks(&info), 0);
+}
+END_TEST
+
+START_TEST(test_skip_ticks_limited) {
+  ExpandedGameInfo_t info = {.timer = 5 * DELAY, .state = Play};
+
+  ck_assert_int_eq(skip_ticks(&info, 2), 2);
+  ck_assert_int_eq(info.timer, 3 * DELAY);
+  ck_assert_int_eq(skip_ticks(&info, 10), 2);
+  ck_assert_int_eq(info.timer, DELAY);
+  ck_assert_int_eq(skip_ticks(&info, 10), 0);
+  update_timer(&info);
+  ck_assert_int_eq(info.state, Shift);
+}
+END_TEST
+
 START_TEST(test_update_current_piece_updates_correctly) {
   ExpandedGameInfo_t info;
 
@@ -111,7 +138,7 @@ START_TEST(test_fill_next_piece_already_placed) {
 END_TEST
 
 START_TEST(test_make_shift_down) {
-  ExpandedGameInfo_t info;
+  ExpandedGameInfo_t info = {.rewind = NULL};
   info.info.field = calloc(FIELD_ROWS, sizeof(int *));
   for (int i = 0; i < FIELD_ROWS; i++) {
     info.info.field[i] = calloc(FIELD_COLS, sizeof(int));
@@ -124,7 +151,7 @@ START_TEST(test_make_shift_down) {
   info.cur_piece = piece;
   info.info.level = 1;
 
-  make_shift(&info);
+  make_shift(&info, NULL);
 
   ck_assert_int_eq(info.cur_piece.coords.row, 6);
   ck_assert_int_eq(info.cur_piece.coords.col, 5);
@@ -143,7 +170,7 @@ START_TEST(test_make_shift_down) {
 END_TEST
 
 START_TEST(test_make_shift_cannot_place) {
-  ExpandedGameInfo_t info;
+  ExpandedGameInfo_t info = {.rewind = NULL};
   info.info.field = calloc(FIELD_ROWS, sizeof(int *));
   for (int i = 0; i < FIELD_ROWS; i++) {
     info.info.field[i] = calloc(FIELD_COLS, sizeof(int));
@@ -158,7 +185,7 @@ START_TEST(test_make_shift_cannot_place) {
   info.next_piece = piece2;
   info.info.level = 1;
 
-  make_shift(&info);
+  make_shift(&info, NULL);
 
   ck_assert_int_eq(info.cur_piece.coords.row, 5);
   ck_assert_int_eq(info.cur_piece.coords.col, 5);
@@ -309,7 +336,7 @@ START_TEST(test_make_move_default) {
 END_TEST
 
 START_TEST(test_clear_full_rows_single_row) {
-  ExpandedGameInfo_t info;
+  ExpandedGameInfo_t info = {.rewind = NULL};
   info.info.field = calloc(FIELD_ROWS, sizeof(int *));
   for (int i = 0; i < FIELD_ROWS; i++) {
     info.info.field[i] = calloc(FIELD_COLS, sizeof(int));
@@ -350,7 +377,7 @@ START_TEST(test_clear_full_rows_single_row) {
 END_TEST
 
 START_TEST(test_clear_full_rows_multiple_rows) {
-  ExpandedGameInfo_t info;
+  ExpandedGameInfo_t info = {.rewind = NULL};
   info.info.field = calloc(FIELD_ROWS, sizeof(int *));
   for (int i = 0; i < FIELD_ROWS; i++) {
     info.info.field[i] = calloc(FIELD_COLS, sizeof(int));
@@ -392,7 +419,7 @@ START_TEST(test_clear_full_rows_multiple_rows) {
 END_TEST
 
 START_TEST(test_clear_full_rows_no_full_rows) {
-  ExpandedGameInfo_t info;
+  ExpandedGameInfo_t info = {.rewind = NULL};
   info.info.field = calloc(FIELD_ROWS, sizeof(int *));
   for (int i = 0; i < FIELD_ROWS; i++) {
     info.info.field[i] = calloc(FIELD_COLS, sizeof(int));
@@ -413,7 +440,7 @@ START_TEST(test_clear_full_rows_no_full_rows) {
 END_TEST
 
 START_TEST(test_clear_full_rows_piece_removal_and_restore) {
-  ExpandedGameInfo_t info;
+  ExpandedGameInfo_t info = {.rewind = NULL};
   info.info.field = calloc(FIELD_ROWS, sizeof(int *));
   for (int i = 0; i < FIELD_ROWS; i++) {
     info.info.field[i] = calloc(FIELD_COLS, sizeof(int));
@@ -576,6 +603,12 @@ Suite *suite_updating() {
   tcase_add_test(tc, test_update_timer_positive_timer);
   tcase_add_test(tc, test_update_timer_negative_timer);
 
+  // get_idle_ticks
+  tcase_add_test(tc, test_get_idle_ticks_play);
+
+  // skip_ticks
+  tcase_add_test(tc, test_skip_ticks_limited);
+
   // update_current_piece
   tcase_add_test(tc, test_update_current_piece_updates_correctly);
 
@@ -0,0 +1,21 @@
+#include "../brick_game/tetris/bot.h"
+#include "../brick_game/tetris/replay.h"
+#include "tetris_test.h"
+
+void steer_bot_piece(ExpandedGameInfo_t *info) {
+  Piece_t target;
+  Path_t path = {.length = 0};
+  if (choose_placement(info, NULL, NULL, &target))
+    find_path(info, target, &path);
+  for (int k = 0; k < path.length; k++) {
+    advance_ticks(info, 3);
+    process_action(info, path.keys[k]);
+  }
+}
+
+void play_bot_piece(ExpandedGameInfo_t *info) {
+  steer_bot_piece(info);
+  process_action(info, Up);
+  skip_ticks(info, 1000);
+  process_input(info, -1, false);
+}
@@ -1,10 +1,19 @@
 #include "tetris_test.h"
 
 int main() {
-  Suite *suite_array[] = {suite_actions(),  suite_instance(), suite_checkups(),
-                          suite_placing(),  suite_moving(),   suite_updating(),
-                          suite_clearing(), suite_values(),   suite_recording(),
-                          suite_specifics()};
+  Suite *suite_array[] = {suite_actions(),   suite_instance(),
+                          suite_checkups(),  suite_placing(),
+                          suite_moving(),    suite_updating(),
+                          suite_clearing(),  suite_values(),
+                          suite_recording(), suite_specifics(),
+                          suite_finesse(),   suite_bot(),
+                          suite_book(),      suite_cache(),
+                          suite_protocol(),  suite_notation(),
+                          suite_changes(),   suite_snapshot(),
+                          suite_replay(),    suite_archive(),
+                          suite_save(),      suite_leaderboard(),
+                          suite_rewind(),    suite_events(),
+                          suite_pool(),      suite_packed()};
   printf("\n");
   for (unsigned long i = 0; i < sizeof(suite_array) / sizeof(suite_array[0]);
        i++) {
@@ -7,6 +7,16 @@
 
 void run_test_cases(Suite *testcase);
 
+/**
+ * @brief Moves the current piece to the bot's placement, three game
+ * iterations apart per key, without dropping it.
+ */
+void steer_bot_piece(ExpandedGameInfo_t *info);
+/**
+ * @brief Plays the current piece as the bot would and spawns the next one.
+ */
+void play_bot_piece(ExpandedGameInfo_t *info);
+
 Suite *suite_actions();
 Suite *suite_instance();
 Suite *suite_checkups();
@@ -17,5 +27,21 @@ Suite *suite_clearing();
 Suite *suite_values();
 Suite *suite_recording();
 Suite *suite_specifics();
+Suite *suite_finesse();
+Suite *suite_bot();
+Suite *suite_book();
+Suite *suite_cache();
+Suite *suite_protocol();
+Suite *suite_notation();
+Suite *suite_changes();
+Suite *suite_snapshot();
+Suite *suite_replay();
+Suite *suite_archive();
+Suite *suite_save();
+Suite *suite_leaderboard();
+Suite *suite_rewind();
+Suite *suite_events();
+Suite *suite_pool();
+Suite *suite_packed();
 
 #endif
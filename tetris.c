@@ -4,80 +4,321 @@
  */
 
 #include "brick_game/tetris/backend.h"
+#include "brick_game/tetris/leaderboard.h"
+#include "brick_game/tetris/protocol.h"
+#include "brick_game/tetris/replay.h"
+#include "brick_game/tetris/rewind.h"
+#include "brick_game/tetris/save.h"
+#include "gui/cli/ansi.h"
+#include "gui/cli/events.h"
 #include "gui/cli/frontend.h"
 
+/**
+ * @brief Structure representing the leaderboard a game is submitted to.
+ */
+typedef struct {
+  Leaderboard_t *board;           /**< The opened leaderboard. */
+  const ExpandedGameInfo_t *game; /**< The game to be submitted. */
+  const char *player;             /**< The player tag. */
+} Ranking_t;
+
 /**
  * @brief Main game loop for the Tetris game.
  *
- * This function represents the main game loop for the Tetris game. It
- * initializes the game windows, sets up the game state, and handles user input
- * and game state updates. The function uses various helper functions to manage
- * the game state, print the game interface, and handle user actions.
+ * This function initializes the game windows and plays the game with
+ * `play_game`, while a render thread draws the published game snapshots in
+ * the windows with `draw_windows`. The static start, pause and game over
+ * screens are printed once on entering their state and again only after a
+ * terminal resize.
+ *
+ * @param record The path to record the session to, or `NULL`.
+ * @param resume The path to the resume file, or `NULL`.
+ * @param player The player tag for the leaderboard.
+ * @param practice A boolean indicating whether the game can be rewound.
  *
  * @see init_wins
  * @see cleanup
+ * @see start_renderer
+ * @see draw_windows
+ * @see play_game
+ */
+void tetris(const char *record, const char *resume, const char *player,
+            bool practice);
+/**
+ * @brief Main game loop for the Tetris game using the raw ANSI renderer.
+ *
+ * This function is the counterpart of `tetris` that draws the game without
+ * ncurses: every frame is composed by the ANSI renderer into one buffer and
+ * written with a single system call.
+ *
+ * @param stats A boolean indicating whether the frame statistics are printed
+ * on exit.
+ * @param half A boolean indicating whether the field is drawn with half
+ * blocks.
+ * @param record The path to record the session to, or `NULL`.
+ * @param resume The path to the resume file, or `NULL`.
+ * @param player The player tag for the leaderboard.
+ * @param practice A boolean indicating whether the game can be rewound.
+ * @return int 0 on success, -1 if the terminal could not be prepared.
+ *
+ * @see tetris
+ * @see init_screen
+ * @see draw_screen
+ * @see print_stats
+ */
+int tetris_ansi(bool stats, bool half, const char *record, const char *resume,
+                const char *player, bool practice);
+/**
+ * @brief Plays the game and publishes its state to the render thread.
+ *
+ * Keys are read by a separate input thread and applied as soon as they
+ * arrive, between the game iterations. While waiting for either the loop
+ * blocks in `next_event`, so an idle game does not consume processor time.
+ * After every event the game state is published as a snapshot, which never
+ * waits for the render thread, so a slow terminal delays neither gravity nor
+ * input handling. If requested, the iterations and actions applied to the
+ * game are recorded to a replay file.
+ *
+ * With a resume file, the game is saved to the file after every event, and a
+ * game found in it on start is restored and paused instead of starting a new
+ * one. The file is cleared when the game is quit normally, so only a crashed
+ * or killed session is resumed. A resumed session is not recorded, since it
+ * cannot be replayed from its seed.
+ *
+ * Every game that ends or is quit with a nonzero score is submitted to the
+ * shared leaderboard in the file given by `get_leaderboard_path`: a game that
+ * tops out is submitted by `rank_game`, subscribed to `Topped_out` on an
+ * event bus attached to the game for the session.
+ *
+ * In practice mode every lock is kept in a rewind history, and the `r` key
+ * takes the game back by `REWIND_TICKS` iterations. A practice game is
+ * neither recorded nor submitted to the leaderboard.
+ *
+ * @param renderer A pointer to the started `Renderer_t` structure.
+ * @param record The path to record the session to, or `NULL`.
+ * @param resume The path to the resume file, or `NULL`.
+ * @param player The player tag for the leaderboard.
+ * @param practice A boolean indicating whether the game can be rewound.
+ *
  * @see get_instance
- * @see print_start
- * @see print_pause
+ * @see init_events
+ * @see next_event
  * @see userInput
- * @see user_action
- * @see clear_wins
- * @see sleep_ms
- * @see print_game_over
- * @see print_game
- * @see updateCurrentState
+ * @see process_action
+ * @see publish_frame
+ * @see open_recorder
+ * @see open_resume
+ * @see update_resume
+ * @see submit_game
+ * @see rank_game
+ * @see subscribe_events
+ * @see get_leaderboard_path
+ * @see rewind_game
+ */
+void play_game(Renderer_t *renderer, const char *record, const char *resume,
+               const char *player, bool practice);
+/**
+ * @brief Submits a game that topped out to the leaderboard.
+ *
+ * This function is the `EventHandler_t` subscribed to `Topped_out` by
+ * `play_game`. Games that end without a score are not submitted.
+ *
+ * @param context A pointer to the `Ranking_t` structure of the game.
+ * @param info A pointer to the `GameInfo_t` structure of the game.
+ * @param event The game event, `Topped_out`.
+ * @param value The final score.
+ *
+ * @see Ranking_t
+ * @see submit_game
  */
-void tetris();
+void rank_game(void *context, const GameInfo_t *info, GameEvent_t event,
+               int value);
+/**
+ * @brief Submits a finished game to the leaderboard.
+ *
+ * @param board A pointer to the opened `Leaderboard_t` structure.
+ * @param info A pointer to the `ExpandedGameInfo_t` structure containing the
+ * game state.
+ * @param player The player tag.
+ * @return int The rank of the game on the board, or `-1` if it did not make
+ * the board.
+ *
+ * @see submit_score
+ */
+int submit_game(Leaderboard_t *board, const ExpandedGameInfo_t *info,
+                const char *player);
 
 /**
  * @brief Main function to start the Tetris game.
  *
  * This function initializes the ncurses library, sets up the color pairs, and
- * starts the Tetris game.
+ * starts the Tetris game. If the program is started with the `--bot` option,
+ * the games are instead played headless by an external bot over the standard
+ * input and output, and the optional next argument sets the number of games.
+ * The `--ansi` option selects the raw ANSI renderer instead of ncurses,
+ * followed in any order by `--half` to draw the field with half blocks and
+ * `--stats` to print the frame statistics on exit. With `--record <file>` the
+ * session is recorded to a replay file, and with `--resume <file>` the game is
+ * continuously saved to a file it is resumed from after a crash, and
+ * `--player <tag>` sets the tag finished games are listed under on the
+ * leaderboard, the user name by default. The `--practice` option lets the
+ * game be rewound. While a game is played interactively, the high score is
+ * saved by a background thread.
  *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
  * @return int The exit status of the program.
  *
  * @see init_ncurses
  * @see init_colorpairs
  * @see tetris
+ * @see run_protocol
+ * @see tetris_ansi
+ * @see start_high_score_writer
  */
-int main() {
-  init_ncurses();
-  start_color();
-  init_colorpairs();
-  bkgdset(COLOR_PAIR(BLACK));
+int main(int argc, char *argv[]) {
+  if (argc > 1 && strcmp(argv[1], "--bot") == 0) {
+    int games = argc > 2 ? atoi(argv[2]) : 1;
+    return run_protocol(stdin, stdout, games) ? 1 : 0;
+  }
+  bool ansi = false, stats = false, half = false, practice = false;
+  const char *record = NULL, *resume = NULL, *player = getenv("USER");
+  if (player == NULL) player = "player";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--ansi") == 0) ansi = true;
+    if (strcmp(argv[i], "--stats") == 0) stats = true;
+    if (strcmp(argv[i], "--half") == 0) half = true;
+    if (strcmp(argv[i], "--practice") == 0) practice = true;
+    if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) record = argv[++i];
+    if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) resume = argv[++i];
+    if (strcmp(argv[i], "--player") == 0 && i + 1 < argc) player = argv[++i];
+  }
+  start_high_score_writer();
+  int res = 0;
+  if (ansi) {
+    res = tetris_ansi(stats, half, record, resume, player, practice) ? 1 : 0;
+  } else {
+    init_ncurses();
+    start_color();
+    init_colorpairs();
+    bkgdset(COLOR_PAIR(BLACK));
 
-  tetris();
+    tetris(record, resume, player, practice);
+  }
+  stop_high_score_writer();
 
-  return 0;
+  return res;
 }
 
-void tetris() {
-  WINDOW *aux = NULL, *field = NULL, *score = NULL, *level = NULL, *next = NULL;
-  init_wins(&aux, &field, &score, &level, &next);
+void tetris(const char *record, const char *resume, const char *player,
+            bool practice) {
+  Display_t display = {.frame = {.valid = false}, .shown = false};
+  init_wins(&display.aux, &display.field, &display.score, &display.level,
+            &display.next);
   refresh();
 
   atexit(cleanup);
 
-  ExpandedGameInfo_t *info = get_instance();
+  Renderer_t renderer;
+  if (start_renderer(&renderer, draw_windows, &display) == 0) {
+    play_game(&renderer, record, resume, player, practice);
+    stop_renderer(&renderer);
+  }
+}
 
-  while (info->state != Exit) {
-    if (info->state == Begin) print_start(aux);
+int tetris_ansi(bool stats, bool half, const char *record, const char *resume,
+                const char *player, bool practice) {
+  Screen_t screen;
+  if (init_screen(&screen, stats, half)) return -1;
 
-    if (info->state == Stop) print_pause(aux);
+  Renderer_t renderer;
+  int res = start_renderer(&renderer, draw_screen, &screen);
+  if (res == 0) {
+    play_game(&renderer, record, resume, player, practice);
+    stop_renderer(&renderer);
+    screen.stats.skipped = renderer.skipped;
+  }
 
-    userInput(user_action(getch()), false);
+  close_screen(&screen);
+  return res;
+}
 
-    if (info->state != info->prev_state) {
-      clear_wins(aux, field, score, level, next);
-      sleep_ms(DELAY);
-    }
+void play_game(Renderer_t *renderer, const char *record, const char *resume,
+               const char *player, bool practice) {
+  ExpandedGameInfo_t *info = get_instance();
+  Resume_t saves;
+  bool saving = resume && open_resume(&saves, resume);
+  const Save_t *save = saving ? find_resume(&saves) : NULL;
+  bool resumed = save != NULL && restore_game(info, save);
+  if (resumed && info->state != Begin && info->state != Game_over) {
+    info->state = Stop;
+    info->info.pause = 1;
+  }
+  Rewind_t rewind;
+  clear_rewind(&rewind);
+  if (practice) info->rewind = &rewind;
+  Recorder_t recorder;
+  bool recording = !resumed && !practice && record &&
+                   open_recorder(&recorder, record, info->seed);
+  Leaderboard_t board;
+  bool ranking = !practice && open_leaderboard(&board, get_leaderboard_path());
+  Ranking_t ranked = {.board = &board, .game = info, .player = player};
+  EventBus_t bus = {.count = 0};
+  if (ranking) {
+    subscribe_events(&bus, rank_game, &ranked, 1u << Topped_out);
+    info->bus = &bus;
+  }
+  Events_t events;
+  init_events(&events);
+  publish_frame(renderer, info, false);
 
-    if (info->state == Game_over) print_game_over(aux);
+  while (info->state != Exit) {
+    GameState_t state = info->state;
+    UserAction_t action;
+    bool tick = next_event(&events, info, &action);
+    if (recording) {
+      record_ticks(&recorder, events.skipped + tick);
+      if (!tick) record_action(&recorder, action);
+    }
+    if (tick)
+      userInput(action, false);
+    else if (practice && (events.key == 'r' || events.key == 'R'))
+      rewind_game(info, REWIND_TICKS);
+    else
+      process_action(info, action);
+    bool quit = info->state == Exit && state != Begin && state != Game_over;
+    if (ranking && quit && info->info.score > 0)
+      submit_game(&board, info, player);
 
-    if (info->state == Play)
-      print_game(field, score, level, next, updateCurrentState());
+    if (info->state != Exit) publish_frame(renderer, info, events.resized);
+    if (saving && info->state != Exit) update_resume(&saves, info);
+    events.resized = false;
   }
+
+  close_events(&events);
+  if (recording) close_recorder(&recorder, info);
+  if (saving) close_resume(&saves, false);
+  if (ranking) close_leaderboard(&board);
+  info->rewind = NULL;
+  info->bus = NULL;
+}
+
+int submit_game(Leaderboard_t *board, const ExpandedGameInfo_t *info,
+                const char *player) {
+  LeaderEntry_t entry = {.score = info->info.score,
+                         .lines = info->lines,
+                         .level = info->info.level,
+                         .timestamp = time(NULL)};
+  strncpy(entry.tag, player, LEADERBOARD_TAG - 1);
+  return submit_score(board, &entry);
+}
+
+void rank_game(void *context, const GameInfo_t *info, GameEvent_t event,
+               int value) {
+  (void)info;
+  (void)event;
+  Ranking_t *ranked = context;
+  if (value > 0) submit_game(ranked->board, ranked->game, ranked->player);
 }
 
 /**
@@ -122,6 +363,60 @@ void tetris() {
  * - Down arrow — accelerate piece
  * - Up arrow — rotate piece
  * - Space — drop piece
+ * - `r` — rewind, in practice mode
+ *
+ * ## Renderers
+ *
+ * Started as `tetris --ansi`, the program draws the game with the raw ANSI
+ * renderer instead of ncurses. Adding `--half` draws two field rows per
+ * terminal row with the `▀` and `▄` half blocks, in 24-bit colors if
+ * `COLORTERM` advertises them and in the 8 basic colors otherwise. Adding
+ * `--stats` prints the number of frames, the bytes written and the time spent
+ * per frame on exit.
+ *
+ * ## Replays
+ *
+ * Started with `--record <file>`, the program records the session to a
+ * compact replay file: a header with the engine version, the rules and the
+ * seed of the piece generator, followed by one varint per action holding the
+ * number of game iterations since the previous action, and a summary of the
+ * final state. See `open_recorder` and `run_replay`.
+ *
+ * Replays can be bundled into a seekable archive holding a keyframe of the full
+ * game state every few game iterations. See `append_archive` and
+ * `seek_archive`.
+ *
+ * ## Crash resume
+ *
+ * Started with `--resume <file>`, the program saves the full game state to a
+ * memory-mapped file after every event and restores it, paused, on the next
+ * start if the previous session was killed or crashed. See `save_game` and
+ * `update_resume`.
+ *
+ * ## Practice mode
+ *
+ * Started with `--practice`, the program keeps the changes made by every lock
+ * in a small ring buffer, and the `r` key rewinds the game by five seconds.
+ * See `rewind_game`.
+ *
+ * ## Leaderboard
+ *
+ * Finished games are ranked on a top-`LEADERBOARD_SIZE` board shared by all
+ * running games of all users through a memory-mapped file, by default
+ * `LEADERBOARD_PATH`. See `get_leaderboard_path`, `submit_score` and
+ * `read_leaderboard`.
+ *
+ * ## Engine events
+ *
+ * The engine only clears rows, scores and checks for the end of the game when
+ * a piece is locked, and reports every lock, row clear, level up, spawn and
+ * top-out to the handlers subscribed with `subscribe_events`.
+ *
+ * ## Bot protocol
+ *
+ * Started as `tetris --bot [games]`, the program runs headless and lets an
+ * external bot play over the standard input and output. See `run_protocol` for
+ * the description of the messages.
  *
  * @author Erik
  * @date 01.10.2024
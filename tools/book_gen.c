@@ -0,0 +1,31 @@
+/**
+ * @file book_gen.c
+ * @brief Opening book generator source file
+ */
+
+#include "../brick_game/tetris/book.h"
+
+/**
+ * @brief Main function of the opening book generator.
+ *
+ * This function generates an opening book with `generate_book`. The optional
+ * first argument sets the number of pieces to be placed from the empty field,
+ * and the optional second argument sets the path to the book file.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return int The exit status of the program.
+ *
+ * @see generate_book
+ */
+int main(int argc, char *argv[]) {
+  int depth = argc > 1 ? atoi(argv[1]) : BOOK_DEPTH;
+  const char *path = argc > 2 ? argv[2] : BOOK_PATH;
+  int count = generate_book(path, depth);
+  if (count < 0) {
+    fprintf(stderr, "Failed to write the opening book to %s\n", path);
+  } else {
+    printf("Wrote %d positions to %s\n", count, path);
+  }
+  return count < 0;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file leaderboard.c
+ * @brief Leaderboard viewer source file
+ */
+
+#include "../brick_game/tetris/leaderboard.h"
+
+/**
+ * @brief Main function of the leaderboard viewer.
+ *
+ * This function prints the leaderboard in the file given as the first
+ * argument, or in the shared file given by `get_leaderboard_path` by default.
+ * The board is read from the shared mapping without blocking running games.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return int The exit status of the program: nonzero if the board could not
+ * be opened.
+ *
+ * @see read_leaderboard
+ */
+int main(int argc, char *argv[]) {
+  const char *path = argc > 1 ? argv[1] : get_leaderboard_path();
+  Leaderboard_t board;
+  if (!open_leaderboard(&board, path)) {
+    fprintf(stderr, "Failed to open the leaderboard %s\n", path);
+    return 1;
+  }
+  LeaderEntry_t entries[LEADERBOARD_SIZE];
+  int count = read_leaderboard(&board, entries);
+  for (int i = 0; i < count; i++) {
+    char date[32];
+    time_t timestamp = (time_t)entries[i].timestamp;
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M", localtime(&timestamp));
+    printf("%2d. %-15s %8d  level %2d  %4d lines  %s\n", i + 1, entries[i].tag,
+           entries[i].score, entries[i].level, entries[i].lines, date);
+  }
+  close_leaderboard(&board);
+  return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file protocol_bot.c
+ * @brief Reference external bot source file
+ */
+
+#include "../brick_game/tetris/bot.h"
+#include "../brick_game/tetris/protocol.h"
+
+/**
+ * @brief Main function of the reference external bot.
+ *
+ * This function speaks the bot side of the protocol described in
+ * `run_protocol` over the standard input and output. Every position is answered
+ * with the placement chosen by `choose_placement`, using the opening book and
+ * the evaluation cache if they are available. Results of finished games are
+ * printed to the standard error.
+ *
+ * @return int The exit status of the program.
+ *
+ * @see run_protocol
+ * @see choose_placement
+ */
+int main() {
+  char line[PROTOCOL_LINE];
+  Book_t book;
+  Cache_t cache;
+  bool has_book = open_book(&book, BOOK_PATH);
+  bool has_cache = open_cache(&cache, CACHE_PATH, CACHE_SLOTS);
+  bool done = false;
+  while (!done && fgets(line, sizeof(line), stdin) != NULL) {
+    int id = 0, cur = 0, next = 0, level = 0, score = 0;
+    char rows[3 * FIELD_ROWS + 1] = "";
+    if (strncmp(line, "tetris", 6) == 0) {
+      printf("ready\n");
+    } else if (sscanf(line, "position %d %60s %d %d %d %d", &id, rows, &cur,
+                      &next, &level, &score) == 6) {
+      Board_t board;
+      init_board(&board, NULL);
+      for (int i = 0; i < FIELD_ROWS; i++) {
+        char digits[4] = {rows[3 * i], rows[3 * i + 1], rows[3 * i + 2], 0};
+        int mask = (int)strtol(digits, NULL, 16);
+        for (int j = 0; j < FIELD_COLS; j++) {
+          board.cells[i][j] = (mask >> j) & 1;
+        }
+      }
+      ExpandedGameInfo_t info = {
+          .info = board.info,
+          .cur_piece = {cur, {SPAWN_ROW, SPAWN_COL}, 0},
+          .next_piece = {next, {SPAWN_ROW, SPAWN_COL}, 0}};
+      Piece_t target;
+      if (choose_placement(&info, has_book ? &book : NULL,
+                           has_cache ? &cache : NULL, &target)) {
+        printf("%d place %d %d\n", id, target.pos, target.coords.col);
+      } else {
+        printf("%d quit\n", id);
+      }
+    } else if (strncmp(line, "gameover", 8) == 0) {
+      fprintf(stderr, "%s", line);
+    } else if (strncmp(line, "bye", 3) == 0) {
+      done = true;
+    }
+    fflush(stdout);
+  }
+  if (has_book) close_book(&book);
+  if (has_cache) close_cache(&cache);
+  return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file replay_archiver.c
+ * @brief Replay archiver source file
+ */
+
+#include "../brick_game/tetris/archive.h"
+
+/**
+ * @brief Main function of the replay archiver.
+ *
+ * This function appends the replay files given after the first argument to
+ * the archive given as the first argument, creating the archive with a
+ * keyframe every `ARCHIVE_INTERVAL` game iterations if it does not exist yet.
+ * The replays of the archive are listed afterwards. The high score file is
+ * left untouched.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return int The exit status of the program: nonzero if any replay could not
+ * be appended.
+ *
+ * @see append_archive
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <archive> [replays...]\n", argv[0]);
+    return 2;
+  }
+  set_high_score_file(NULL);
+  Archive_t archive;
+  bool ok = open_archive(&archive, argv[1]) ||
+            create_archive(argv[1], ARCHIVE_INTERVAL);
+  close_archive(&archive);
+  for (int i = 2; i < argc && ok; i++) {
+    Replay_t replay;
+    if (!load_replay(&replay, argv[i]) || !append_archive(argv[1], &replay)) {
+      fprintf(stderr, "Failed to append %s\n", argv[i]);
+      ok = false;
+    }
+    free_replay(&replay);
+  }
+  if (ok && open_archive(&archive, argv[1])) {
+    printf("%zu replays, a keyframe every %u iterations\n", archive.count,
+           archive.header->interval);
+    for (size_t i = 0; i < archive.count; i++) {
+      const ArchiveEntry_t *entry = archive.entries[i];
+      printf("%zu: seed %llu, %llu iterations, %u keyframes, score %d%s\n", i,
+             (unsigned long long)entry->seed,
+             (unsigned long long)entry->ticks, entry->keyframes,
+             entry->summary.score, entry->complete ? "" : " (incomplete)");
+    }
+    close_archive(&archive);
+  } else if (ok) {
+    fprintf(stderr, "Failed to open the archive %s\n", argv[1]);
+    ok = false;
+  }
+  return !ok;
+}
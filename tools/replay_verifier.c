@@ -0,0 +1,146 @@
+/**
+ * @file replay_verifier.c
+ * @brief Parallel replay verifier source file
+ */
+
+#include "../brick_game/tetris/replay.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+/**
+ * @brief Structure representing the replays shared by the verifier threads.
+ */
+typedef struct {
+  char **paths;        /**< The paths to the replay files. */
+  int count;           /**< The number of replay files. */
+  atomic_int next;     /**< The index of the next replay to be verified. */
+  atomic_int failed;   /**< The number of replays that failed verification. */
+  atomic_ullong ticks; /**< The number of game iterations replayed. */
+} Verification_t;
+
+/**
+ * @brief Lists the replay files in a directory.
+ *
+ * @param dir The path to the directory.
+ * @param count A pointer the number of files found is written to.
+ * @return char** The allocated array of paths, or `NULL` if the directory
+ * cannot be read.
+ */
+static char **list_replays(const char *dir, int *count) {
+  DIR *stream = opendir(dir);
+  char **paths = NULL;
+  int capacity = 0;
+  *count = 0;
+  struct dirent *entry;
+  while (stream != NULL && (entry = readdir(stream)) != NULL) {
+    size_t length = strlen(entry->d_name);
+    if (length > 4 && strcmp(entry->d_name + length - 4, ".rpl") == 0) {
+      if (*count == capacity) {
+        capacity = capacity ? 2 * capacity : 64;
+        paths = realloc(paths, capacity * sizeof(char *));
+      }
+      paths[*count] = malloc(strlen(dir) + length + 2);
+      sprintf(paths[*count], "%s/%s", dir, entry->d_name);
+      (*count)++;
+    }
+  }
+  if (stream != NULL) closedir(stream);
+  return stream != NULL && paths == NULL ? calloc(1, sizeof(char *)) : paths;
+}
+
+/**
+ * @brief Verifies replays until none are left.
+ *
+ * Each thread takes the next replay from the shared counter, so threads that
+ * get short replays simply verify more of them.
+ *
+ * @param arg A pointer to the shared `Verification_t` structure.
+ * @return void* Always `NULL`.
+ */
+static void *verify_replays(void *arg) {
+  Verification_t *work = arg;
+  int index;
+  while ((index = atomic_fetch_add(&work->next, 1)) < work->count) {
+    ReplaySummary_t expected, result;
+    ReplayStatus_t status = verify_replay(work->paths[index], &expected,
+                                          &result);
+    atomic_fetch_add(&work->ticks, result.ticks);
+    if (status == Replay_mismatch) {
+      fprintf(stderr,
+              "%s: mismatch: score %d/%d, level %d/%d, lines %d/%d, "
+              "ticks %llu/%llu\n",
+              work->paths[index], result.score, expected.score, result.level,
+              expected.level, result.lines, expected.lines,
+              (unsigned long long)result.ticks,
+              (unsigned long long)expected.ticks);
+    } else if (status != Replay_valid) {
+      fprintf(stderr, "%s: %s\n", work->paths[index],
+              status == Replay_incomplete ? "incomplete" : "unreadable");
+    }
+    if (status != Replay_valid) atomic_fetch_add(&work->failed, 1);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Main function of the replay verifier.
+ *
+ * This function plays back every `.rpl` file of the directory given as the
+ * first argument with `verify_replay` and reports the replays whose final
+ * score, level, lines or number of iterations differ from the recorded
+ * summary. The replays are spread over as many threads as there are online
+ * processors, or over the number given as the optional second argument. The
+ * high score file is left untouched.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return int The exit status of the program: nonzero if any replay failed.
+ *
+ * @see verify_replay
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <dir> [threads]\n", argv[0]);
+    return 2;
+  }
+  Verification_t work = {.count = 0};
+  work.paths = list_replays(argv[1], &work.count);
+  if (work.paths == NULL) {
+    fprintf(stderr, "Failed to read the directory %s\n", argv[1]);
+    return 2;
+  }
+  long threads = argc > 2 ? atol(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+  if (threads < 1) threads = 1;
+  if (threads > work.count) threads = work.count ? work.count : 1;
+  set_high_score_file(NULL);
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  pthread_t *pool = malloc(threads * sizeof(pthread_t));
+  for (long i = 0; i < threads; i++) {
+    pthread_create(&pool[i], NULL, verify_replays, &work);
+  }
+  for (long i = 0; i < threads; i++) {
+    pthread_join(pool[i], NULL);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double seconds =
+      (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  if (seconds <= 0) seconds = 1e-9;
+  unsigned long long ticks = atomic_load(&work.ticks);
+  int failed = atomic_load(&work.failed);
+
+  printf("Verified %d replays on %ld threads in %.3f s: %d failed\n",
+         work.count, threads, seconds, failed);
+  printf("%.1f replays/s, %.0f ticks/s\n", work.count / seconds,
+         ticks / seconds);
+  for (int i = 0; i < work.count; i++) {
+    free(work.paths[i]);
+  }
+  free(work.paths);
+  free(pool);
+  return failed != 0;
+}